@@ -1,12 +1,20 @@
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "../Tree/LevelIndex.hpp"
+#include "../Tree/PreOrderColumn.hpp"
 #include "../Tree/Tree.hpp"
 
 #include "DriveScanner.h"
 #include "Stopwatch.hpp"
+#include "SubtreeSketches.h"
 
 namespace
 {
@@ -147,6 +155,277 @@ int main()
       << "Average Post-Order Traversal Time: " << RunTrials<ChronoType>(postOrderTraversal)
       << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
 
+   // The same pre-order traversal, with the pointers to the visited files being gathered into
+   // batches first, so that the summation runs as a plain loop over each batch:
+   const auto batchedPreOrderTraversal = [&] () noexcept
+   {
+      std::uintmax_t treeSize{ 0 };
+      std::uintmax_t totalBytes{ 0 };
+
+      std::array<const FileInfo*, 256> batch;
+      auto itr = tree->beginPreOrder();
+
+      while (const auto count = itr.NextBatch(batch.data(), batch.size()))
+      {
+         treeSize += count;
+
+         for (std::size_t index{ 0 }; index < count; ++index)
+         {
+            const auto& file = *batch[index];
+            totalBytes += (file.type == FileType::REGULAR) ? file.size : 0;
+         }
+      }
+   };
+
+   std::cout
+      << "Average Batched Pre-Order Traversal Time: "
+      << RunTrials<ChronoType>(batchedPreOrderTraversal)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   // The same summation, with the tree being divided among all cores; every thread accumulates
+   // into its own totals, which are padded to avoid false sharing:
+   const auto parallelTraversal = [&] ()
+   {
+      struct alignas(64) Totals
+      {
+         std::uintmax_t treeSize{ 0 };
+         std::uintmax_t totalBytes{ 0 };
+      };
+
+      ParallelOptions options;
+      options.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+      std::vector<Totals> totals(options.threadCount);
+
+      Tree<FileInfo>::ParallelForEach(*tree->GetRoot(),
+         [&] (const auto& node, unsigned int thread) noexcept
+      {
+         auto& threadTotals = totals[thread];
+         threadTotals.treeSize += 1;
+
+         if (node.GetData().type == FileType::REGULAR)
+         {
+            threadTotals.totalBytes += node.GetData().size;
+         }
+      }, options);
+   };
+
+   std::cout
+      << "Average Parallel Traversal Time: " << RunTrials<ChronoType>(parallelTraversal)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   // Per-directory node counts and nesting depths, each as a single parallel fold that leaves the
+   // results in a pre-order side array:
+   const auto countAllSubtrees = [&] ()
+   {
+      const auto counts = Tree<FileInfo>::ParallelFoldUp(*tree->GetRoot(),
+         [] (const auto&) noexcept { return std::uintmax_t{ 1 }; },
+         std::plus<std::uintmax_t>{ });
+
+      return counts.front();
+   };
+
+   const auto heights = Tree<FileInfo>::ParallelFoldUp(*tree->GetRoot(),
+      [] (const auto&) noexcept { return 0u; },
+      [] (unsigned int height, unsigned int child) noexcept
+   {
+      return std::max(height, child + 1);
+   });
+
+   std::cout << "Deepest Nesting Below the Root: " << heights.front() << "\n";
+
+   std::cout
+      << "Average Parallel Subtree Count Time: " << RunTrials<ChronoType>(countAllSubtrees)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   // The same traversals, with a few of the Nodes coming up being kept prefetched:
+   for (const std::size_t distance : { 1u, 4u, 16u })
+   {
+      const auto prefetchedPreOrderTraversal = [&] () noexcept
+      {
+         std::uintmax_t treeSize{ 0 };
+         std::uintmax_t totalBytes{ 0 };
+
+         std::for_each(
+            tree->beginPreOrderPrefetched(distance),
+            tree->endPreOrderPrefetched(),
+            [&] (const auto& node) noexcept
+         {
+            treeSize += 1;
+
+            if (node.GetData().type == FileType::REGULAR)
+            {
+               totalBytes += node.GetData().size;
+            }
+         });
+      };
+
+      const auto prefetchedPostOrderTraversal = [&] () noexcept
+      {
+         std::uintmax_t treeSize{ 0 };
+         std::uintmax_t totalBytes{ 0 };
+
+         std::for_each(
+            tree->beginPrefetched(distance),
+            tree->endPrefetched(),
+            [&] (const auto& node) noexcept
+         {
+            treeSize += 1;
+
+            if (node.GetData().type == FileType::REGULAR)
+            {
+               totalBytes += node.GetData().size;
+            }
+         });
+      };
+
+      std::cout
+         << "Average Pre-Order Traversal Time (Prefetch Distance " << distance << "): "
+         << RunTrials<ChronoType>(prefetchedPreOrderTraversal)
+         << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+      std::cout
+         << "Average Post-Order Traversal Time (Prefetch Distance " << distance << "): "
+         << RunTrials<ChronoType>(prefetchedPostOrderTraversal)
+         << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+   }
+
+   // Interactive queries, such as the size of each top-level directory, either need to traverse
+   // every subtree, or can be answered from a pre-order column:
+   const auto sizeOf = [] (const auto& node) noexcept
+   {
+      return node->type == FileType::REGULAR ? node->size : std::uintmax_t{ 0 };
+   };
+
+   const auto subtreeSumsByTraversal = [&] () noexcept
+   {
+      std::uintmax_t totalBytes{ 0 };
+
+      for (auto* child = tree->GetRoot()->GetFirstChild(); child; child = child->GetNextSibling())
+      {
+         std::for_each(
+            Tree<FileInfo>::PreOrderIterator{ child },
+            Tree<FileInfo>::PreOrderIterator{ },
+            [&] (const auto& node) noexcept { totalBytes += sizeOf(node); });
+      }
+   };
+
+   const PreOrderColumn<Tree<FileInfo>, std::uintmax_t> sizeColumn{ *tree, sizeOf };
+
+   const auto subtreeSumsByColumn = [&] () noexcept
+   {
+      std::uintmax_t totalBytes{ 0 };
+
+      // The root sits at position zero, and its children follow one another, each one starting
+      // right where the subtree of the previous one ends:
+      for (std::size_t child{ 1 }; child < sizeColumn.Size(); child = sizeColumn.SubtreeEnd(child))
+      {
+         totalBytes += sizeColumn.SubtreeSum(child);
+      }
+   };
+
+   std::cout
+      << "Average Subtree Sum Time (Traversal): "
+      << RunTrials<ChronoType>(subtreeSumsByTraversal)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   std::cout
+      << "Average Subtree Sum Time (Pre-Order Column): "
+      << RunTrials<ChronoType>(subtreeSumsByColumn)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   // Showing the top levels of the Tree, either by filtering a full traversal by depth, or by
+   // only gathering the levels that are actually needed:
+   constexpr auto VISIBLE_DEPTH{ 3u };
+
+   const auto topLevelsByTraversal = [&] () noexcept
+   {
+      std::size_t visibleNodes{ 0 };
+
+      std::for_each(tree->beginPreOrder(), tree->endPreOrder(), [&] (const auto& node) noexcept
+      {
+         visibleNodes += (Tree<FileInfo>::Depth(node) <= VISIBLE_DEPTH);
+      });
+   };
+
+   const auto topLevelsByIndex = [&] ()
+   {
+      std::size_t visibleNodes{ 0 };
+
+      LevelIndex<Tree<FileInfo>> levels{ *tree };
+      for (auto depth{ 0u }; depth <= VISIBLE_DEPTH; ++depth)
+      {
+         visibleNodes += levels.Level(depth).size();
+      }
+   };
+
+   std::cout
+      << "Average Top Levels Time (Traversal): " << RunTrials<ChronoType>(topLevelsByTraversal)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   std::cout
+      << "Average Top Levels Time (Level Index): " << RunTrials<ChronoType>(topLevelsByIndex)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   std::unique_ptr<SubtreeSketches> sketches;
+
+   const auto sketchBuild = Stopwatch<ChronoType>([&]
+   {
+      sketches = std::make_unique<SubtreeSketches>(*tree);
+   });
+
+   std::cout
+      << "Subtree Sketch Construction Time: " << sketchBuild.GetElapsedTime().count()
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n"
+      << "Median File Size: " << sketches->SizeQuantile(*tree->GetRoot(), 0.5) << " bytes.\n"
+      << "99th Percentile File Size: " << sketches->SizeQuantile(*tree->GetRoot(), 0.99)
+      << " bytes.\n"
+      << "Distinct Extensions: " << sketches->DistinctExtensions(*tree->GetRoot()) << ".\n";
+
+   // A synthetic directory with a hundred thousand files of pseudo-random sizes:
+   Tree<FileInfo> directory{ FileInfo{ "Directory", ExtensionTable::NO_EXTENSION, 0,
+      FileType::DIRECTORY } };
+
+   std::uintmax_t seed{ 1 };
+   for (auto index{ 0u }; index < 100'000u; ++index)
+   {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      directory.GetRoot()->AppendChild(
+         FileInfo{ "File", ExtensionTable::NO_EXTENSION, seed >> 24, FileType::REGULAR });
+   }
+
+   // Each trial sorts by size and then by a scrambled size, so that no trial starts out with an
+   // already sorted directory:
+   const auto scramble = [] (std::uintmax_t size) noexcept { return size * 0x9E3779B97F4A7C15ull; };
+
+   const auto sortByComparator = [&] () noexcept
+   {
+      directory.GetRoot()->SortChildren([] (const auto& lhs, const auto& rhs) noexcept
+      {
+         return lhs->size < rhs->size;
+      });
+
+      directory.GetRoot()->SortChildren([&] (const auto& lhs, const auto& rhs) noexcept
+      {
+         return scramble(lhs->size) < scramble(rhs->size);
+      });
+   };
+
+   const auto sortByKey = [&] () noexcept
+   {
+      directory.GetRoot()->SortChildrenBy([] (const auto& node) noexcept { return node->size; });
+      directory.GetRoot()->SortChildrenBy(
+         [&] (const auto& node) noexcept { return scramble(node->size); });
+   };
+
+   std::cout
+      << "Average Sort Time (Comparator): " << RunTrials<ChronoType>(sortByComparator)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
+   std::cout
+      << "Average Sort Time (Extracted Key): " << RunTrials<ChronoType>(sortByKey)
+      << " " << StopwatchInternals::TypeName<ChronoType>::value << ".\n";
+
    std::cout << std::endl;
 
    return 0;
@@ -1,13 +1,18 @@
 #include "DriveScanner.h"
 
-#include "IgnoreUnused.hpp"
 #include "ScopedHandle.h"
 #include "Stopwatch.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #pragma warning(push )
@@ -15,65 +20,153 @@
 #include <boost/asio/post.hpp>
 #pragma warning(pop)
 
-#include <fileapi.h>
-#include <WinIoCtl.h>
+#include <Windows.h>
 
 namespace
 {
    std::mutex streamMutex;
 
    /**
-   * @brief Use the `FindFirstFileW(...)` function to retrieve the file size.
+   * On NTFS, the file index is a reference into the Master File Table: the low 48 bits hold the
+   * MFT record number, and the high 16 bits hold a sequence number that gets bumped whenever a
+   * record is reused.
+   */
+   constexpr std::uint64_t RECORD_NUMBER_MASK{ 0x0000FFFFFFFFFFFF };
+
+   /**
+   * @brief Reads the complete listing of a directory, using a single directory handle.
    *
-   * The `std::experimental::filesystem::file_size(...)` function uses a different native function
-   * to get at the file size for a given file, and this function (while probably faster than
-   * `FindFirstFileW(...)`) has a tendency to throw. If such exceptional behaviour were to occur,
-   * then this function can be used to hopefully still get at the file size.
+   * Along with the name of every entry, the listing includes each entry's size, attributes,
+   * reparse tag, and file index, so that none of those need to be queried separately.
    *
-   * @param path[in]               The path to the troublesome file.
+   * @param[in] path                The path to the directory.
+   * @param[out] entries            The entries found in the directory.
+   * @param[out] names              The names of all entries, back-to-back; each DirectoryEntry
+   *                                records where in this string its own name is located.
    *
-   * @returns The size of the file if it's accessible, and zero otherwise.
+   * @returns True if the directory could be read, and false otherwise.
    */
-   std::uintmax_t GetFileSizeUsingWinAPI(const std::experimental::filesystem::path& path)
+   bool ReadDirectoryListing(
+      const std::wstring& path,
+      std::vector<DirectoryEntry>& entries,
+      std::wstring& names) noexcept
    {
-      std::uintmax_t fileSize{ 0 };
+      entries.clear();
+      names.clear();
 
-      WIN32_FIND_DATA fileData;
-      const HANDLE fileHandle = FindFirstFileW(path.wstring().data(), &fileData);
-      if (fileHandle == INVALID_HANDLE_VALUE)
+      const ScopedHandle handle
       {
-         return 0;
+         CreateFileW(
+            /* fileName = */ path.c_str(),
+            /* desiredAccess = */ FILE_LIST_DIRECTORY,
+            /* shareMode = */ FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            /* securityAttributes = */ 0,
+            /* creationDisposition = */ OPEN_EXISTING,
+            /* flagsAndAttributes = */ FILE_FLAG_BACKUP_SEMANTICS,
+            /* templateFile = */ 0)
+      };
+
+      if (!handle.IsValid())
+      {
+         // In some edge-cases, the Windows operating system doesn't allow anyone to access
+         // certain directories. One example of such a directory in Windows 7 is:
+         // "C:\System Volume Information".
+         return false;
       }
 
-      const auto highWord = static_cast<std::uintmax_t>(fileData.nFileSizeHigh);
-      fileSize = (highWord << sizeof(fileData.nFileSizeLow) * 8) | fileData.nFileSizeLow;
+      // The listing is returned in batches; the buffer has to be suitably aligned for the
+      // 64-bit members of FILE_ID_BOTH_DIR_INFO:
+      thread_local std::vector<std::uint64_t> buffer(64 * 1024 / sizeof(std::uint64_t));
+      const auto bufferSize = static_cast<DWORD>(buffer.size() * sizeof(std::uint64_t));
+
+      while (GetFileInformationByHandleEx(
+         handle, FileIdBothDirectoryInfo, buffer.data(), bufferSize))
+      {
+         const auto* rawEntry = reinterpret_cast<const std::byte*>(buffer.data());
 
-      return fileSize;
+         while (true)
+         {
+            const auto& info = *reinterpret_cast<const FILE_ID_BOTH_DIR_INFO*>(rawEntry);
+
+            const std::wstring_view name{ info.FileName, info.FileNameLength / sizeof(wchar_t) };
+            if (name != L"." && name != L"..")
+            {
+               // The reparse tag is reported in place of the extended attribute size:
+               const auto isReparsePoint = info.FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT;
+
+               entries.emplace_back(DirectoryEntry
+               {
+                  static_cast<std::uint64_t>(info.FileId.QuadPart),
+                  static_cast<std::uintmax_t>(info.EndOfFile.QuadPart),
+                  names.size(),
+                  name.size(),
+                  info.FileAttributes,
+                  isReparsePoint ? info.EaSize : 0
+               });
+
+               names.append(name);
+            }
+
+            if (info.NextEntryOffset == 0)
+            {
+               break;
+            }
+
+            rawEntry += info.NextEntryOffset;
+         }
+      }
+
+      return GetLastError() == ERROR_NO_MORE_FILES;
    }
 
    /**
-   * @brief Helper function to safely wrap the retrieval of a file's size.
+   * @brief Moves the subdirectories of a directory listing to the end of the listing, and sorts
+   * them so that they can be opened in the order in which their metadata is laid out on disk.
+   * The files keep their relative order, since they never have to be opened at all.
    *
-   * @param path[in]               The path to the file.
+   * Only the MFT record number, and not the sequence number, says anything about the on-disk
+   * location of an entry's metadata.
    *
-   * @return The size of the file if it's accessible, and zero otherwise.
+   * @returns The index of the first subdirectory in the listing.
    */
-   std::uintmax_t ComputeFileSize(const std::experimental::filesystem::path& path) noexcept
+   std::size_t SortDirectoriesByFileIndex(std::vector<DirectoryEntry>& entries)
    {
-      assert(!std::experimental::filesystem::is_directory(path));
-
-      try
+      const auto firstDirectory = std::stable_partition(std::begin(entries), std::end(entries),
+         [] (const DirectoryEntry& entry) noexcept
       {
-         return std::experimental::filesystem::file_size(path);
-      }
-      catch (...)
+         return !(entry.attributes & FILE_ATTRIBUTE_DIRECTORY);
+      });
+
+      std::sort(firstDirectory, std::end(entries),
+         [] (const DirectoryEntry& lhs, const DirectoryEntry& rhs) noexcept
       {
-         const std::lock_guard<std::mutex> lock{ streamMutex };
-         IgnoreUnused(lock);
+         return (lhs.fileIndex & RECORD_NUMBER_MASK) < (rhs.fileIndex & RECORD_NUMBER_MASK);
+      });
+
+      return static_cast<std::size_t>(std::distance(std::begin(entries), firstDirectory));
+   }
 
-         std::wcout << "Falling back on the Win API for: \"" << path.wstring() << "\"" << std::endl;
-         return GetFileSizeUsingWinAPI(path);
+   /**
+   * @brief Splits a file name into its stem and its extension.
+   *
+   * This follows the same rules as `std::experimental::filesystem::path::stem()` and
+   * `std::experimental::filesystem::path::extension()`, but returns views into the given name
+   * instead of allocating new strings.
+   *
+   * @param[in] fileName            The name of the file, without any leading directories.
+   *
+   * @returns The stem and the extension (including the leading dot) of the file.
+   */
+   std::pair<std::wstring_view, std::wstring_view> SplitFileName(
+      std::wstring_view fileName) noexcept
+   {
+      const auto dot = fileName.rfind(L'.');
+      if (dot == std::wstring_view::npos || dot == 0 || fileName == L"..")
+      {
+         return { fileName, std::wstring_view{ } };
       }
+
+      return { fileName.substr(0, dot), fileName.substr(dot) };
    }
 
    /**
@@ -87,56 +180,48 @@ namespace
    */
    void PruneEmptyFilesAndDirectories(Tree<FileInfo>& tree)
    {
-      std::vector<Tree<FileInfo>::Node*> toBeDeleted;
-
-      for (auto&& node : tree)
-      {
-         if (node->size == 0)
-         {
-            toBeDeleted.emplace_back(&node);
-         }
-      }
-
-      const auto nodesRemoved = toBeDeleted.size();
-
-      for (auto* node : toBeDeleted)
-      {
-         node->DeleteFromTree();
-      }
+      const auto nodesRemoved = tree.RemoveIf(
+         [] (const Tree<FileInfo>::Node& node) noexcept { return node->size == 0; },
+         std::execution::par);
 
       std::cout << "Number of Sizeless Files Removed: " << nodesRemoved << std::endl;
    }
 
    /**
-   * @brief Performs a post-processing step that iterates through the tree and computes the size
-   * of all directories.
+   * @brief Performs a post-processing step that computes the size of all directories, with
+   * disjoint subtrees being summed up concurrently.
    *
    * @param[in, out] tree          The tree whose nodes need their directory sizes computed.
    */
    void ComputeDirectorySizes(Tree<FileInfo>& tree)
    {
-      for (auto&& node : tree)
+      if (!tree.GetRoot())
       {
-         Tree<FileInfo>::Node* parent = node.GetParent();
-         if (!parent)
-         {
-            return;
-         }
+         return;
+      }
 
-         FileInfo& parentInfo = parent->GetData();
-         if (parentInfo.type == FileType::DIRECTORY)
+      Tree<FileInfo>::ParallelFoldUpInto(*tree.GetRoot(),
+         [] (const Tree<FileInfo>::Node& node) noexcept { return node->size; },
+         std::plus<std::uintmax_t>{ },
+         [] (Tree<FileInfo>::Node& node, std::uintmax_t size) noexcept
+      {
+         if (node->type == FileType::DIRECTORY)
          {
-            parentInfo.size += node->size;
+            node->size = size;
          }
-      }
+      });
    }
 
    /**
    * @brief Contructs the root node for the file tree.
    *
    * @param[in] path                The path to the directory that should constitute the root node.
+   * @param[in] fileNames           The arena that will hold the names of all files in the tree.
+   *                                The returned tree keeps this arena alive.
    */
-   std::shared_ptr<Tree<FileInfo>> CreateTreeAndRootNode(const std::experimental::filesystem::path& path)
+   std::shared_ptr<Tree<FileInfo>> CreateTreeAndRootNode(
+      const std::experimental::filesystem::path& path,
+      const std::shared_ptr<StringArena>& fileNames)
    {
       if (!std::experimental::filesystem::is_directory(path))
       {
@@ -145,269 +230,361 @@ namespace
 
       FileInfo fileInfo
       {
-         path.wstring(),
-         /* extension = */ L"",
+         fileNames->Store(path.wstring()),
+         ExtensionTable::NO_EXTENSION,
          DriveScanner::SIZE_UNDEFINED,
          FileType::DIRECTORY
       };
 
-      return std::make_shared<Tree<FileInfo>>(Tree<FileInfo>(std::move(fileInfo)));
-   }
-
-   /**
-   * @returns A handle representing the repartse point found at the given path. If
-   * the path is not a reparse point, then an invalid handle will be returned instead.
-   */
-   ScopedHandle OpenReparsePoint(const std::experimental::filesystem::path& path)
-   {
-      const auto handle = CreateFile(
-         /* fileName = */ path.wstring().c_str(),
-         /* desiredAccess = */ GENERIC_READ,
-         /* shareMode = */ 0,
-         /* securityAttributes = */ 0,
-         /* creationDisposition = */ OPEN_EXISTING,
-         /* flagsAndAttributes = */ FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT,
-         /* templateFile = */ 0);
-
-      return ScopedHandle{ handle };
+      return std::shared_ptr<Tree<FileInfo>>(
+         new Tree<FileInfo>{ std::move(fileInfo) },
+         [fileNames] (Tree<FileInfo>* tree) noexcept { delete tree; });
    }
 
    /**
-   * @brief Reads the reparse point found at the given path into the output buffer.
+   * @brief Retrieves the identity of the file or directory at the given path, using a single
+   * metadata query.
    *
-   * @returns True if the path could be read as a reparse point, and false otherwise.
+   * @param[in] path                The full path to the file or directory.
+   * @param[out] identity           The identity of the file or directory.
+   *
+   * @returns True if the file or directory could be queried, and false otherwise.
    */
-   bool ReadReparsePoint(
+   bool QueryFileIdentity(
       const std::wstring& path,
-      std::vector<std::byte>& reparseBuffer)
+      FileIdentity& identity) noexcept
    {
-      const auto handle = OpenReparsePoint(path);
+      const ScopedHandle handle
+      {
+         CreateFileW(
+            /* fileName = */ path.c_str(),
+            /* desiredAccess = */ FILE_READ_ATTRIBUTES,
+            /* shareMode = */ FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            /* securityAttributes = */ 0,
+            /* creationDisposition = */ OPEN_EXISTING,
+            /* flagsAndAttributes = */ FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT,
+            /* templateFile = */ 0)
+      };
+
       if (!handle.IsValid())
       {
          return false;
       }
 
-      DWORD bytesReturned{ 0 };
-
-      const auto successfullyRetrieved = DeviceIoControl(
-         /* device = */ handle,
-         /* controlCode = */ FSCTL_GET_REPARSE_POINT,
-         /* inBuffer = */ NULL,
-         /* inBufferSize = */ 0,
-         /* outBuffer = */ reinterpret_cast<LPVOID>(reparseBuffer.data()),
-         /* outBufferSize = */ static_cast<DWORD>(reparseBuffer.size()),
-         /* bytesReturned = */ &bytesReturned,
-         /* overlapped = */ 0) == TRUE;
+      BY_HANDLE_FILE_INFORMATION fileInfo = { 0 };
 
-      return successfullyRetrieved && bytesReturned;
-   }
+      const auto successfullyRetrieved = GetFileInformationByHandle(handle, &fileInfo);
+      if (!successfullyRetrieved)
+      {
+         return false;
+      }
 
-   /**
-   * @returns True if the given file path matches the given reparse tag, and false otherwise. 
-   */
-   bool IsReparseTag(
-      const std::experimental::filesystem::path& path,
-      DWORD targetTag)
-   {
-      static std::vector<std::byte> buffer{ MAXIMUM_REPARSE_DATA_BUFFER_SIZE };
+      const auto highIndex = static_cast<std::uint64_t>(fileInfo.nFileIndexHigh);
 
-      const auto successfullyRead = ReadReparsePoint(path, buffer);
+      identity.volume = fileInfo.dwVolumeSerialNumber;
+      identity.index = (highIndex << 32) | fileInfo.nFileIndexLow;
 
-      return successfullyRead
-         ? reinterpret_cast<REPARSE_DATA_BUFFER*>(buffer.data())->ReparseTag == targetTag
-         : false;
+      return true;
    }
 
    /**
-   * @returns True if the given file path represents a mount point, and false otherwise.
+   * @returns True if the given directory entry represents a symlink or a mount point, and false
+   * otherwise.
    *
-   * @note Junctions in Windows are considered mount points.
+   * @note Junctions in Windows are considered mount points. The reparse tag comes for free with
+   * the directory listing, so no additional handle has to be opened to figure this out.
    */
-   bool IsMountPoint(const std::experimental::filesystem::path& path)
+   bool IsSymlinkOrMountPoint(
+      const DirectoryEntry& entry,
+      const std::wstring& path)
    {
-      const auto isMountPoint = IsReparseTag(path, IO_REPARSE_TAG_MOUNT_POINT);
-
-      if (isMountPoint)
+      if (!(entry.attributes & FILE_ATTRIBUTE_REPARSE_POINT))
       {
-         const std::lock_guard<decltype(streamMutex)> lock{ streamMutex };
-         std::wcout << L"Found Mount Point: " << path.wstring() << L'\n';
+         return false;
       }
 
-      return isMountPoint;
-   }
-
-   /**
-   * @returns True if the given file path represents a symlink, and false otherwise.
-   */
-   bool IsSymlink(const std::experimental::filesystem::path& path)
-   {
-      const auto isSymlink = IsReparseTag(path, IO_REPARSE_TAG_SYMLINK);
-
-      if (isSymlink)
+      const auto reparseTag = entry.reparseTag;
+      if (reparseTag == IO_REPARSE_TAG_MOUNT_POINT)
       {
          const std::lock_guard<decltype(streamMutex)> lock{ streamMutex };
-         std::wcout << L"Found Symlink: " << path.wstring() << L'\n';
-      }
+         std::wcout << L"Found Mount Point: " << path << L'\n';
 
-      return isSymlink;
-   }
-
-   /**
-   * @returns True is the given file path matches any of the listed reparse tag, and false
-   * otherwise.
-   */
-   bool IsUnknownReparsePoint(const std::experimental::filesystem::path& path)
-   {
-      constexpr auto reparseTag =
-         IO_REPARSE_TAG_MOUNT_POINT |
-         IO_REPARSE_TAG_HSM |
-         IO_REPARSE_TAG_DRIVE_EXTENDER |
-         IO_REPARSE_TAG_HSM2 |
-         IO_REPARSE_TAG_SIS |
-         IO_REPARSE_TAG_WIM |
-         IO_REPARSE_TAG_CSV |
-         IO_REPARSE_TAG_DFS |
-         IO_REPARSE_TAG_FILTER_MANAGER |
-         IO_REPARSE_TAG_IIS_CACHE |
-         IO_REPARSE_TAG_DFSR |
-         IO_REPARSE_TAG_DEDUP |
-         IO_REPARSE_TAG_APPXSTRM |
-         IO_REPARSE_TAG_NFS |
-         IO_REPARSE_TAG_FILE_PLACEHOLDER |
-         IO_REPARSE_TAG_DFM |
-         IO_REPARSE_TAG_WOF;
-
-      const auto isRandomReparse = IsReparseTag(path, reparseTag);
-
-      if (isRandomReparse)
-      {
-         const std::lock_guard<decltype(streamMutex)> lock{ streamMutex };
-         std::wcout << L"Found unkown: " << path.wstring() << L'\n';
+         return true;
       }
 
-      return isRandomReparse;
-   }
-
-   /**
-   * @returns True if the given path represents a reparse point, and false otherwise.
-   */
-   bool IsReparsePoint(const std::experimental::filesystem::path& path)
-   {
-      const ScopedHandle handle = OpenReparsePoint(path);
-      if (!handle.IsValid())
+      if (reparseTag == IO_REPARSE_TAG_SYMLINK)
       {
-         return false;
-      }
-
-      BY_HANDLE_FILE_INFORMATION fileInfo = { 0 };
+         const std::lock_guard<decltype(streamMutex)> lock{ streamMutex };
+         std::wcout << L"Found Symlink: " << path << L'\n';
 
-      const auto successfullyRetrieved = GetFileInformationByHandle(handle, &fileInfo);
-      if (!successfullyRetrieved)
-      {
-         return false;
+         return true;
       }
 
-      return fileInfo.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT;
+      return false;
    }
 }
 
-DriveScanner::DriveScanner(const std::experimental::filesystem::path& path) :
+DriveScanner::DriveScanner(
+   const std::experimental::filesystem::path& path,
+   ScanOptions options)
+   :
+   m_fileTree{ CreateTreeAndRootNode(path, m_fileNames) },
    m_rootPath{ path },
-   m_fileTree{ CreateTreeAndRootNode(path) }
+   m_options{ options }
 {
 }
 
-void DriveScanner::ProcessFile(
-   const std::experimental::filesystem::path& path,
-   Tree<FileInfo>::Node& node) noexcept
+/**
+* @brief The state shared by all chunks of a directory listing that is processed in parallel.
+*/
+struct DriveScanner::ParallelQuery
 {
-   const auto fileSize = ComputeFileSize(path);
-   if (fileSize == 0u)
+   ParallelQuery(
+      std::wstring directoryPath,
+      std::vector<DirectoryEntry> entries,
+      std::wstring names,
+      Tree<FileInfo>::Node& node,
+      std::size_t chunkSize)
+      :
+      directoryPath{ std::move(directoryPath) },
+      entries{ std::move(entries) },
+      names{ std::move(names) },
+      node{ node },
+      chunkSize{ chunkSize },
+      chunkCount{ (this->entries.size() + chunkSize - 1) / chunkSize },
+      chunkNodes{ std::make_unique<Tree<FileInfo>::Node[]>(chunkCount) },
+      chunksRemaining{ chunkCount }
    {
-      return;
    }
 
-   FileInfo fileInfo
-   {
-      path.filename().stem().wstring(),
-      path.filename().extension().wstring(),
-      fileSize,
-      FileType::REGULAR
-   };
+   const std::wstring directoryPath;
+   const std::vector<DirectoryEntry> entries;
+   const std::wstring names;
 
-   const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
-   node.AppendChild(std::move(fileInfo));
-}
+   Tree<FileInfo>::Node& node;
+
+   const std::size_t chunkSize;
+   const std::size_t chunkCount;
+
+   // Each chunk collects its files under a private staging Node, so that the chunks don't have to
+   // synchronize with one another:
+   std::unique_ptr<Tree<FileInfo>::Node[]> chunkNodes;
+
+   std::atomic<std::size_t> chunksRemaining;
+};
 
 void DriveScanner::ProcessDirectory(
-   const std::experimental::filesystem::path& path,
+   const std::wstring& path,
    Tree<FileInfo>::Node& node) noexcept
 {
-   bool isRegularFile = false;
-   try
+   // These buffers are reused for every directory that this thread visits, so that, once they've
+   // grown large enough, scanning a directory no longer allocates anything but the tree nodes:
+   thread_local std::vector<DirectoryEntry> entries;
+   thread_local std::wstring names;
+   thread_local std::wstring directoryPath;
+   thread_local std::vector<FileInfo> files;
+
+   const auto isReadable = ReadDirectoryListing(path, entries, names);
+   if (!isReadable || entries.empty())
+   {
+      // The node for a subdirectory is appended before its listing is read, so empty and
+      // inaccessible directories are only discovered here, and dropped again:
+      if (&node != m_fileTree->GetRoot())
+      {
+         const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
+         node.DeleteFromTree();
+      }
+
+      return;
+   }
+
+   directoryPath.assign(path);
+   if (!directoryPath.empty() && directoryPath.back() != L'\\' && directoryPath.back() != L'/')
    {
-      // In certain cases, this function can, apparently, raise exceptions, although it
-      // isn't entirely clear to me what circumstances need to exist for this to occur:
-      isRegularFile = std::experimental::filesystem::is_regular_file(path);
+      directoryPath.push_back(L'\\');
    }
-   catch (...)
+
+   if (m_options.orderByFileIndex)
    {
+      // The subdirectories are opened right here, one after the other, since splitting them
+      // across the thread-pool would throw the order away again. Only the files are left over:
+      const auto firstDirectory = SortDirectoriesByFileIndex(entries);
+
+      ProcessEntries(directoryPath, entries.data() + firstDirectory,
+         entries.data() + entries.size(), names, node, files);
+
+      entries.resize(firstDirectory);
+   }
+
+   if (entries.size() >= m_options.parallelQueryThreshold && m_options.parallelQueryChunkSize)
+   {
+      QueueParallelQuery(std::make_shared<ParallelQuery>(
+         directoryPath, std::move(entries), std::move(names), node,
+         m_options.parallelQueryChunkSize));
+
       return;
    }
 
-   if (isRegularFile)
+   files.clear();
+
+   ProcessEntries(
+      directoryPath, entries.data(), entries.data() + entries.size(), names, node, files);
+
+   const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
+
+   for (const auto& fileInfo : files)
    {
-      ProcessFile(path, node);
+      node.AppendChild(fileInfo);
    }
-   else if (std::experimental::filesystem::is_directory(path) && !IsSymlink(path) && !IsMountPoint(path))
+}
+
+void DriveScanner::ProcessEntries(
+   const std::wstring& directoryPath,
+   const DirectoryEntry* begin,
+   const DirectoryEntry* end,
+   const std::wstring& names,
+   Tree<FileInfo>::Node& node,
+   std::vector<FileInfo>& files) noexcept
+{
+   thread_local std::wstring pathBuffer;
+
+   pathBuffer.assign(directoryPath);
+   const auto directoryLength = pathBuffer.size();
+
+   for (const auto* entry = begin; entry != end; ++entry)
    {
-      try
+      const std::wstring_view fileName{ names.data() + entry->nameOffset, entry->nameLength };
+
+      // Full paths are built in place, and only because the metadata query needs one:
+      pathBuffer.resize(directoryLength);
+      pathBuffer.append(fileName);
+
+      if (entry->attributes & FILE_ATTRIBUTE_DIRECTORY)
       {
-         // In some edge-cases, the Windows operating system doesn't allow anyone to access certain
-         // directories, and attempts to do so will result in exceptional behaviour---pun intended.
-         // In order to deal with these rare cases, we'll need to rely on a try-catch to keep going.
-         // One example of a problematic directory in Windows 7 is: "C:\System Volume Information".
-         if (std::experimental::filesystem::is_empty(path))
+         if (IsSymlinkOrMountPoint(*entry, pathBuffer) || IsOnOtherVolume(pathBuffer))
          {
-            return;
+            continue;
          }
+
+         ProcessSubdirectory(pathBuffer, fileName, node);
       }
-      catch (...)
+      else
       {
-         return;
+         if (entry->size == 0u || IsDuplicateHardLink(*entry))
+         {
+            continue;
+         }
+
+         const auto [stem, extension] = SplitFileName(fileName);
+
+         files.emplace_back(
+            m_fileNames->Store(stem),
+            ExtensionTable::Get().Intern(extension),
+            entry->size,
+            FileType::REGULAR);
       }
+   }
+}
 
-      FileInfo directoryInfo
+void DriveScanner::QueueParallelQuery(const std::shared_ptr<ParallelQuery>& query) noexcept
+{
+   for (std::size_t chunk{ 0 }; chunk < query->chunkCount; ++chunk)
+   {
+      boost::asio::post(m_threadPool, [this, query, chunk] () noexcept
       {
-         path.filename().wstring(),
-         /* extension = */ L"",
-         DriveScanner::SIZE_UNDEFINED,
-         FileType::DIRECTORY
-      };
+         thread_local std::vector<FileInfo> files;
+         files.clear();
 
-      std::unique_lock<decltype(m_mutex)> lock{ m_mutex };
-      auto* const lastChild = node.AppendChild(std::move(directoryInfo));
-      lock.unlock();
+         const auto* const begin = query->entries.data() + chunk * query->chunkSize;
+         const auto* const end = query->entries.data()
+            + std::min(query->entries.size(), (chunk + 1) * query->chunkSize);
 
-      auto itr = std::experimental::filesystem::directory_iterator{ path };
-      AddDirectoriesToQueue(itr, *lastChild);
+         ProcessEntries(query->directoryPath, begin, end, query->names, query->node, files);
+
+         auto& chunkNode = query->chunkNodes[chunk];
+         for (const auto& fileInfo : files)
+         {
+            chunkNode.AppendChild(fileInfo);
+         }
+
+         const auto isLastChunk = query->chunksRemaining.fetch_sub(1) == 1;
+         if (!isLastChunk)
+         {
+            return;
+         }
+
+         const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
+
+         for (std::size_t index{ 0 }; index < query->chunkCount; ++index)
+         {
+            query->node.SpliceChildren(query->chunkNodes[index]);
+         }
+      });
    }
 }
 
-void DriveScanner::AddDirectoriesToQueue(
-   std::experimental::filesystem::directory_iterator& itr,
-   Tree<FileInfo>::Node& node) noexcept
+void DriveScanner::ProcessSubdirectory(
+   const std::wstring& path,
+   std::wstring_view name,
+   Tree<FileInfo>::Node& parentNode) noexcept
 {
-   const auto end = std::experimental::filesystem::directory_iterator{ };
-   while (itr != end)
+   FileInfo directoryInfo
    {
-      boost::asio::post(m_threadPool, [&, path = itr->path()] () noexcept
-      {
-         ProcessDirectory(path, node);
-      });
+      m_fileNames->Store(name),
+      ExtensionTable::NO_EXTENSION,
+      DriveScanner::SIZE_UNDEFINED,
+      FileType::DIRECTORY
+   };
+
+   std::unique_lock<decltype(m_mutex)> lock{ m_mutex };
+   auto* const directoryNode = parentNode.AppendChild(std::move(directoryInfo));
+   lock.unlock();
 
-      ++itr;
+   boost::asio::post(m_threadPool, [this, directoryNode, directoryPath = path] () noexcept
+   {
+      ProcessDirectory(directoryPath, *directoryNode);
+   });
+}
+
+bool DriveScanner::IsOnOtherVolume(const std::wstring& path) noexcept
+{
+   FileIdentity identity{ };
+
+   if (!m_rootVolume || !QueryFileIdentity(path, identity))
+   {
+      // If we can't tell, then we'll err on the side of including the directory:
+      return false;
+   }
+
+   if (identity.volume == *m_rootVolume)
+   {
+      return false;
+   }
+
+   const std::lock_guard<decltype(streamMutex)> lock{ streamMutex };
+   std::wcout << L"Skipping Different Volume: " << path << L'\n';
+
+   return true;
+}
+
+bool DriveScanner::IsDuplicateHardLink(const DirectoryEntry& entry) noexcept
+{
+   // File systems without stable file indices, such as FAT, report zero for every file:
+   if (entry.fileIndex == 0u)
+   {
+      return false;
+   }
+
+   // Directories on other volumes are never descended into, so every file that is listed lives on
+   // the same volume as the root of the scan, and the record number alone identifies it. While
+   // the scan runs, no record can be reused, so the sequence number can be dropped as well:
+   const auto isFirstLink = m_hardLinks.Insert(entry.fileIndex & RECORD_NUMBER_MASK);
+   if (!isFirstLink)
+   {
+      ++m_duplicateHardLinks;
    }
+
+   return !isFirstLink;
 }
 
 std::shared_ptr<Tree<FileInfo>> DriveScanner::GetTree()
@@ -417,17 +594,25 @@ std::shared_ptr<Tree<FileInfo>> DriveScanner::GetTree()
 
 void DriveScanner::Start()
 {
+   FileIdentity rootIdentity{ };
+
+   if (QueryFileIdentity(m_rootPath.wstring(), rootIdentity))
+   {
+      m_rootVolume = rootIdentity.volume;
+   }
+
    Stopwatch<std::chrono::seconds>([&] () noexcept
    {
       boost::asio::post(m_threadPool, [&] () noexcept
       {
-         auto itr = std::experimental::filesystem::directory_iterator{ m_rootPath };
-         AddDirectoriesToQueue(itr, *m_fileTree->GetRoot());
+         ProcessDirectory(m_rootPath.wstring(), *m_fileTree->GetRoot());
       });
 
       m_threadPool.join();
    }, "\nScanned Drive in ");
 
+   std::cout << "Number of Duplicate Hard Links Skipped: " << m_duplicateHardLinks << std::endl;
+
    const auto treeSize = m_fileTree->Size();
 
    ComputeDirectorySizes(*m_fileTree);
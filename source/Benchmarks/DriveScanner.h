@@ -7,7 +7,10 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #pragma warning(push )
 #pragma warning(disable: 4996)
@@ -16,6 +19,8 @@
 
 #include "../Tree/Tree.hpp"
 #include "FileInfo.hpp"
+#include "StringArena.h"
+#include "ThreadSafeSet.hpp"
 #include "WinHack.hpp"
 
 /**
@@ -27,6 +32,67 @@ struct NodeAndPath
    std::experimental::filesystem::path path;
 };
 
+/**
+* @brief Uniquely identifies a file on the system, regardless of the path used to reach it.
+*
+* This is the Windows equivalent of a POSIX (device, inode) pair: the serial number of the volume
+* that the file lives on, and the index of the file on that volume.
+*/
+struct FileIdentity
+{
+   std::uint64_t volume;
+   std::uint64_t index;
+
+   friend bool operator==(const FileIdentity& lhs, const FileIdentity& rhs) noexcept
+   {
+      return lhs.volume == rhs.volume && lhs.index == rhs.index;
+   }
+};
+
+/**
+* @brief Settings that control how the DriveScanner goes about its work.
+*/
+struct ScanOptions
+{
+   /**
+   * Whether the subdirectories of each directory should be opened in file index order, rather
+   * than in the order in which the directory lists them. Subdirectories are the only entries that
+   * get opened, for the volume check; everything else comes with the listing. On rotational disks
+   * and some network file systems, the file index tracks the on-disk location of the metadata far
+   * more closely than the listing order does, so this cuts down on seeking. To keep that order,
+   * the subdirectories are opened by a single thread, even in listings that are otherwise split
+   * across the thread-pool.
+   */
+   bool orderByFileIndex{ false };
+
+   /**
+   * Directories with at least this many entries have the metadata of their entries queried by
+   * several threads at once, so that a single huge directory doesn't end up dominating the tail
+   * end of the scan.
+   */
+   std::size_t parallelQueryThreshold{ 16 * 1024 };
+
+   /**
+   * The number of entries handed to each thread when a directory is processed in parallel.
+   */
+   std::size_t parallelQueryChunkSize{ 4 * 1024 };
+};
+
+/**
+* @brief A single entry of a directory listing.
+*/
+struct DirectoryEntry
+{
+   std::uint64_t fileIndex;
+   std::uintmax_t size;
+
+   std::size_t nameOffset;
+   std::size_t nameLength;
+
+   std::uint32_t attributes;
+   std::uint32_t reparseTag;
+};
+
 /**
 * @brief The Drive Scanner class
 */
@@ -36,7 +102,9 @@ public:
 
    static constexpr std::uintmax_t SIZE_UNDEFINED{ 0 };
 
-   explicit DriveScanner(const std::experimental::filesystem::path& path);
+   explicit DriveScanner(
+      const std::experimental::filesystem::path& path,
+      ScanOptions options = { });
 
    /**
    * @brief Kicks off the drive scanning process.
@@ -51,42 +119,100 @@ public:
 private:
 
    /**
-   * @brief Helper function to process a single file.
-   *
-   * @note This function assumes the path is valid and accessible.
+   * @brief Scans the contents of a single directory. Files are appended to the directory's Node
+   * directly, while subdirectories are handed off to the thread-pool.
    *
    * @param[in] path                The location on disk to scan.
-   * @param[in] fileNode            The Node in Tree to append newly discoved files to.
+   * @param[in] node                The Node in Tree to append newly discoved files to.
    */
-   void ProcessFile(
-      const std::experimental::filesystem::path& path,
+   void ProcessDirectory(
+      const std::wstring& path,
       Tree<FileInfo>::Node& node) noexcept;
 
    /**
-   * @brief Performs a recursive depth-first exploration of the file system.
+   * @brief Queries the metadata of a range of entries from a directory listing. Subdirectories
+   * are handed off to the thread-pool right away, while files are collected in the output vector.
    *
-   * @param[in] path                The location on disk to scan.
-   * @param[in] fileNode            The Node in Tree to append newly discoved files to.
+   * @param[in] directoryPath       The path to the directory, including a trailing separator.
+   * @param[in] begin               The first entry to process.
+   * @param[in] end                 One past the last entry to process.
+   * @param[in] names               The names of the entries in the listing.
+   * @param[in] node                The Node representing the directory.
+   * @param[out] files              The files that should be added to the directory's Node.
    */
-   void ProcessDirectory(
-      const std::experimental::filesystem::path& path,
-      Tree<FileInfo>::Node& fileNode) noexcept;
+   void ProcessEntries(
+      const std::wstring& directoryPath,
+      const DirectoryEntry* begin,
+      const DirectoryEntry* end,
+      const std::wstring& names,
+      Tree<FileInfo>::Node& node,
+      std::vector<FileInfo>& files) noexcept;
+
+   struct ParallelQuery;
 
    /**
-   * @brief Adds directories to thread-pool queue.
+   * @brief Splits the processing of a very large directory listing into chunks that are handled
+   * by the thread-pool in parallel. Once the last chunk is done, the files from all chunks are
+   * spliced into the directory's Node at once.
    *
-   * @param[in] itr                 Reference to the directory to iterate over.
-   * @param[in] Node                The Node to append the contents of the directory to.
+   * @param[in] query               The listing to process.
    */
-   void AddDirectoriesToQueue(
-      std::experimental::filesystem::directory_iterator& itr,
-      Tree<FileInfo>::Node& node) noexcept;
+   void QueueParallelQuery(const std::shared_ptr<ParallelQuery>& query) noexcept;
+
+   /**
+   * @brief Appends a Node for the given subdirectory, and queues up the scan of its contents.
+   *
+   * @param[in] path                The full path to the subdirectory.
+   * @param[in] name                The name of the subdirectory.
+   * @param[in] parentNode          The Node representing the parent directory.
+   */
+   void ProcessSubdirectory(
+      const std::wstring& path,
+      std::wstring_view name,
+      Tree<FileInfo>::Node& parentNode) noexcept;
+
+   /**
+   * @brief Decides whether the directory that was just found should be skipped, because it lives
+   * on a different volume than the root of the scan.
+   *
+   * @note The volume of the directory is retrieved with a single metadata query. Files can only
+   * ever live on the same volume as the directory that lists them, so they needn't be checked.
+   *
+   * @param[in] path                The full path to the directory.
+   *
+   * @returns True if the directory should be skipped, and false otherwise.
+   */
+   bool IsOnOtherVolume(const std::wstring& path) noexcept;
+
+   /**
+   * @brief Decides whether the file that was just found should be skipped, because it is a hard
+   * link to a file that has already been counted.
+   *
+   * @note The directory listing doesn't report the number of links to a file, so the MFT record
+   * number of every file is recorded; in exchange, no file ever has to be opened. Each record
+   * number is stored in a flat table, at a cost of 11 to 22 bytes per file.
+   *
+   * @param[in] entry               The directory entry of the file.
+   *
+   * @returns True if the file should be skipped, and false otherwise.
+   */
+   bool IsDuplicateHardLink(const DirectoryEntry& entry) noexcept;
+
+   std::shared_ptr<StringArena> m_fileNames{ std::make_shared<StringArena>() };
 
    std::shared_ptr<Tree<FileInfo>> m_fileTree{ nullptr };
  
    const std::experimental::filesystem::path m_rootPath;
 
+   const ScanOptions m_options;
+
    std::mutex m_mutex;
 
+   std::optional<std::uint64_t> m_rootVolume;
+
+   ThreadSafeSet<std::uint64_t> m_hardLinks;
+
+   std::atomic<std::uintmax_t> m_duplicateHardLinks{ 0 };
+
    boost::asio::thread_pool m_threadPool{ 6 };
 };
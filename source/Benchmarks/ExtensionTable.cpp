@@ -0,0 +1,80 @@
+#include "ExtensionTable.h"
+
+#include "Utf8.hpp"
+
+#include <cassert>
+#include <mutex>
+
+ExtensionTable& ExtensionTable::Get()
+{
+   static ExtensionTable table;
+   return table;
+}
+
+ExtensionTable::ExtensionTable()
+{
+   m_extensions.emplace_back();
+   m_identifiers.emplace(m_extensions.back(), NO_EXTENSION);
+}
+
+ExtensionId ExtensionTable::Intern(std::string_view extension)
+{
+   if (extension.empty())
+   {
+      return NO_EXTENSION;
+   }
+
+   {
+      const std::shared_lock<decltype(m_mutex)> lock{ m_mutex };
+
+      const auto match = m_identifiers.find(extension);
+      if (match != std::end(m_identifiers))
+      {
+         return match->second;
+      }
+   }
+
+   const std::unique_lock<decltype(m_mutex)> lock{ m_mutex };
+
+   // Another thread may have added the same extension while we weren't holding the lock:
+   const auto match = m_identifiers.find(extension);
+   if (match != std::end(m_identifiers))
+   {
+      return match->second;
+   }
+
+   const auto id = static_cast<ExtensionId>(m_extensions.size());
+   m_extensions.emplace_back(extension);
+   m_identifiers.emplace(m_extensions.back(), id);
+
+   return id;
+}
+
+ExtensionId ExtensionTable::Intern(std::wstring_view extension)
+{
+   if (extension.empty())
+   {
+      return NO_EXTENSION;
+   }
+
+   thread_local std::string buffer;
+
+   buffer.resize(Utf8::EncodedLength(extension));
+   Utf8::Encode(extension, buffer.data());
+
+   return Intern(std::string_view{ buffer });
+}
+
+std::string_view ExtensionTable::Lookup(ExtensionId id) const
+{
+   const std::shared_lock<decltype(m_mutex)> lock{ m_mutex };
+
+   assert(id < m_extensions.size());
+   return m_extensions[id];
+}
+
+std::size_t ExtensionTable::Size() const
+{
+   const std::shared_lock<decltype(m_mutex)> lock{ m_mutex };
+   return m_extensions.size();
+}
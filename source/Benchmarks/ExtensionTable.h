@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+* @brief Small integer handle to an interned file extension.
+*/
+using ExtensionId = std::uint32_t;
+
+/**
+* @brief The ExtensionTable class interns file extensions, so that each distinct extension is only
+* ever stored once, no matter how many files share it.
+*
+* The table is process-wide; an ExtensionId remains valid for the lifetime of the program.
+*/
+class ExtensionTable
+{
+public:
+
+   /**
+   * @brief The identifier of the empty extension.
+   */
+   static constexpr ExtensionId NO_EXTENSION{ 0 };
+
+   /**
+   * @returns The process-wide extension table.
+   */
+   static ExtensionTable& Get();
+
+   ExtensionTable(const ExtensionTable&) = delete;
+   ExtensionTable& operator=(const ExtensionTable&) = delete;
+
+   /**
+   * @brief Looks up the identifier of the given UTF-8 extension, adding it if it hasn't been seen
+   * before.
+   */
+   ExtensionId Intern(std::string_view extension);
+
+   /**
+   * @overload
+   *
+   * @note The extension is converted to UTF-8 in a reusable, per-thread buffer.
+   */
+   ExtensionId Intern(std::wstring_view extension);
+
+   /**
+   * @returns The UTF-8 extension associated with the given identifier.
+   */
+   std::string_view Lookup(ExtensionId id) const;
+
+   /**
+   * @returns The number of distinct extensions interned so far, including the empty one.
+   */
+   std::size_t Size() const;
+
+private:
+
+   ExtensionTable();
+
+   // A deque never relocates its elements, so views into these strings remain valid as more
+   // extensions get added:
+   std::deque<std::string> m_extensions;
+
+   std::unordered_map<std::string_view, ExtensionId> m_identifiers;
+
+   mutable std::shared_mutex m_mutex;
+};
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <cassert>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
+
+#include "ExtensionTable.h"
+#include "Utf8.hpp"
 
 /**
 * @brief The FILE_TYPE enum represents the three basic file types: non-directory files,
 * directories, and symbolic links (which includes junctions).
 */
-enum class FileType
+enum class FileType : std::uint8_t
 {
    REGULAR,
    DIRECTORY,
@@ -16,13 +22,97 @@ enum class FileType
 
 /**
 * @brief The FileInfo struct
+*
+* To keep the per-file footprint of very large scans down, names aren't owned by the FileInfo.
+* Instead, the name is a UTF-8 view into the StringArena owned by the scan that produced it, and
+* the extension is a handle into the process-wide ExtensionTable.
 */
 struct FileInfo
 {
-   std::wstring name;
-   std::wstring extension;
+   FileInfo() noexcept = default;
+
+   /**
+   * @param[in] name                UTF-8 name; the underlying storage has to outlive the FileInfo.
+   * @param[in] extension           The interned extension.
+   * @param[in] size                The size of the file in bytes.
+   * @param[in] type                The type of file.
+   */
+   FileInfo(
+      std::string_view name,
+      ExtensionId extension,
+      std::uintmax_t size,
+      FileType type) noexcept
+      :
+      size{ size },
+      m_name{ name.data() },
+      m_extension{ extension },
+      m_nameLength{ static_cast<std::uint16_t>(name.size()) },
+      type{ type }
+   {
+      assert(name.size() <= std::numeric_limits<decltype(m_nameLength)>::max());
+   }
+
+   /**
+   * @returns The UTF-8 encoded name of the file, without its extension.
+   */
+   std::string_view Name() const noexcept
+   {
+      return { m_name, m_nameLength };
+   }
+
+   /**
+   * @returns The UTF-8 encoded extension of the file, including the leading dot.
+   */
+   std::string_view Extension() const
+   {
+      return ExtensionTable::Get().Lookup(m_extension);
+   }
+
+   /**
+   * @returns The name of the file, without its extension, decoded into the wide string that the
+   * `name` member used to hold.
+   *
+   * @note This allocates; prefer Name() wherever UTF-8 will do.
+   */
+   std::wstring WideName() const
+   {
+      return Utf8::Decode(Name());
+   }
+
+   /**
+   * @returns The extension of the file, including the leading dot, decoded into the wide string
+   * that the `extension` member used to hold.
+   *
+   * @note This allocates; prefer Extension() or GetExtensionId() wherever those will do.
+   */
+   std::wstring WideExtension() const
+   {
+      return Utf8::Decode(Extension());
+   }
+
+   /**
+   * @returns The interned extension.
+   */
+   ExtensionId GetExtensionId() const noexcept
+   {
+      return m_extension;
+   }
 
-   std::uintmax_t size;
+   std::uintmax_t size{ 0 };
 
-   FileType type;
+private:
+
+   // @note The members are ordered so that the struct packs into 24 bytes.
+
+   const char* m_name{ nullptr };
+
+   ExtensionId m_extension{ ExtensionTable::NO_EXTENSION };
+
+   std::uint16_t m_nameLength{ 0 };
+
+public:
+
+   FileType type{ FileType::REGULAR };
 };
+
+static_assert(sizeof(void*) != 8 || sizeof(FileInfo) == 24, "FileInfo should stay compact.");
@@ -0,0 +1,81 @@
+#include "HyperLogLog.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+HyperLogLog::HyperLogLog(std::uint8_t precision) :
+   m_precision{ std::clamp(precision, MIN_PRECISION, MAX_PRECISION) }
+{
+   m_registers.resize(std::size_t{ 1 } << m_precision);
+}
+
+void HyperLogLog::Add(std::uint64_t hash)
+{
+   const auto index = hash >> (64 - m_precision);
+
+   // The sentinel bit caps the rank, should all remaining bits of the hash be zero:
+   const auto remainder = (hash << m_precision) | (std::uint64_t{ 1 } << (m_precision - 1));
+   const auto rank = static_cast<std::uint8_t>(std::countl_zero(remainder) + 1);
+
+   auto& reg = m_registers[index];
+   reg = std::max(reg, rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other)
+{
+   assert(m_precision == other.m_precision);
+
+   std::transform(
+      std::begin(m_registers), std::end(m_registers),
+      std::begin(other.m_registers),
+      std::begin(m_registers),
+      [] (std::uint8_t lhs, std::uint8_t rhs) noexcept { return std::max(lhs, rhs); });
+}
+
+std::uint64_t HyperLogLog::Estimate() const
+{
+   const auto registerCount = static_cast<double>(m_registers.size());
+
+   double alpha;
+   switch (m_registers.size())
+   {
+      case 16: alpha = 0.673; break;
+      case 32: alpha = 0.697; break;
+      case 64: alpha = 0.709; break;
+      default: alpha = 0.7213 / (1.0 + 1.079 / registerCount); break;
+   }
+
+   double sum{ 0.0 };
+   std::size_t emptyRegisters{ 0 };
+
+   for (const auto reg : m_registers)
+   {
+      sum += std::ldexp(1.0, -static_cast<int>(reg));
+      emptyRegisters += (reg == 0);
+   }
+
+   const auto estimate = alpha * registerCount * registerCount / sum;
+
+   // Small cardinalities are estimated far more accurately by linear counting:
+   if (estimate <= 2.5 * registerCount && emptyRegisters > 0)
+   {
+      const auto linearCount =
+         registerCount * std::log(registerCount / static_cast<double>(emptyRegisters));
+
+      return static_cast<std::uint64_t>(std::llround(linearCount));
+   }
+
+   return static_cast<std::uint64_t>(std::llround(estimate));
+}
+
+std::uint64_t HyperLogLog::Hash(std::uint64_t value) noexcept
+{
+   // The SplitMix64 finalizer:
+   value += 0x9E3779B97F4A7C15ull;
+   value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+   value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+   return value ^ (value >> 31);
+}
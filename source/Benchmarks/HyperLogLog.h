@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+* @brief The HyperLogLog class estimates the number of distinct values in a stream, in a fixed
+* amount of memory.
+*
+* The sketch holds 2^precision one-byte registers, and its estimates have a standard error of
+* roughly 1.04 / sqrt(2^precision). Two sketches with the same precision can be merged into a
+* sketch of the union of both streams.
+*/
+class HyperLogLog
+{
+public:
+
+   static constexpr std::uint8_t MIN_PRECISION{ 4 };
+   static constexpr std::uint8_t MAX_PRECISION{ 16 };
+
+   /**
+   * @param[in] precision           The base-two logarithm of the number of registers; clamped to
+   *                                [MIN_PRECISION, MAX_PRECISION].
+   */
+   explicit HyperLogLog(std::uint8_t precision);
+
+   /**
+   * @brief Adds a value to the sketch.
+   *
+   * @param[in] hash                A well-mixed 64-bit hash of the value.
+   */
+   void Add(std::uint64_t hash);
+
+   /**
+   * @brief Adds all values seen by the other sketch to this one.
+   *
+   * @note Both sketches need to have the same precision.
+   */
+   void Merge(const HyperLogLog& other);
+
+   /**
+   * @returns The estimated number of distinct values added to the sketch.
+   */
+   std::uint64_t Estimate() const;
+
+   /**
+   * @returns A well-mixed 64-bit hash of the specified integer.
+   */
+   static std::uint64_t Hash(std::uint64_t value) noexcept;
+
+private:
+
+   std::vector<std::uint8_t> m_registers;
+
+   std::uint8_t m_precision;
+};
@@ -0,0 +1,172 @@
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+
+QuantileSketch::QuantileSketch(
+   double relativeAccuracy,
+   std::size_t maxBuckets)
+   :
+   m_gamma{ (1.0 + relativeAccuracy) / (1.0 - relativeAccuracy) },
+   m_logGamma{ std::log(m_gamma) },
+   m_maxBuckets{ std::max<std::size_t>(maxBuckets, 1) }
+{
+   assert(relativeAccuracy > 0.0 && relativeAccuracy < 1.0);
+}
+
+std::size_t QuantileSketch::BucketsToCover(
+   double relativeAccuracy,
+   std::uintmax_t minValue,
+   std::uintmax_t maxValue)
+{
+   assert(relativeAccuracy > 0.0 && relativeAccuracy < 1.0);
+
+   const auto logGamma = std::log((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy));
+
+   const auto lowestIndex = std::ceil(std::log(static_cast<double>(std::max<std::uintmax_t>(
+      minValue, 1))) / logGamma);
+
+   const auto highestIndex = std::ceil(std::log(static_cast<double>(std::max<std::uintmax_t>(
+      maxValue, 1))) / logGamma);
+
+   return static_cast<std::size_t>(highestIndex - lowestIndex) + 1;
+}
+
+void QuantileSketch::Add(std::uintmax_t value)
+{
+   ++m_count;
+
+   if (value == 0)
+   {
+      ++m_zeroCount;
+      return;
+   }
+
+   const auto index = BucketIndex(value);
+
+   const auto match = std::lower_bound(std::begin(m_buckets), std::end(m_buckets), index,
+      [] (const Bucket& bucket, std::int32_t index) noexcept { return bucket.first < index; });
+
+   if (match != std::end(m_buckets) && match->first == index)
+   {
+      ++match->second;
+      return;
+   }
+
+   m_buckets.emplace(match, index, 1);
+   Collapse();
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other)
+{
+   assert(m_gamma == other.m_gamma);
+
+   if (other.m_buckets.empty())
+   {
+      m_zeroCount += other.m_zeroCount;
+      m_count += other.m_count;
+
+      return;
+   }
+
+   std::vector<Bucket> merged;
+   merged.reserve(m_buckets.size() + other.m_buckets.size());
+
+   auto lhs = std::begin(m_buckets);
+   auto rhs = std::begin(other.m_buckets);
+
+   const auto lhsEnd = std::end(m_buckets);
+   const auto rhsEnd = std::end(other.m_buckets);
+
+   while (lhs != lhsEnd || rhs != rhsEnd)
+   {
+      if (rhs == rhsEnd || (lhs != lhsEnd && lhs->first < rhs->first))
+      {
+         merged.emplace_back(*lhs++);
+      }
+      else if (lhs == lhsEnd || rhs->first < lhs->first)
+      {
+         merged.emplace_back(*rhs++);
+      }
+      else
+      {
+         merged.emplace_back(lhs->first, lhs->second + rhs->second);
+         ++lhs;
+         ++rhs;
+      }
+   }
+
+   m_buckets.swap(merged);
+
+   m_zeroCount += other.m_zeroCount;
+   m_count += other.m_count;
+
+   Collapse();
+}
+
+std::uintmax_t QuantileSketch::Quantile(double quantile) const
+{
+   if (m_count == 0)
+   {
+      return 0;
+   }
+
+   const auto rank = static_cast<std::uintmax_t>(
+      std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count - 1));
+
+   if (rank < m_zeroCount)
+   {
+      return 0;
+   }
+
+   auto seen = m_zeroCount;
+   for (const auto& bucket : m_buckets)
+   {
+      seen += bucket.second;
+      if (seen > rank)
+      {
+         return BucketValue(bucket.first);
+      }
+   }
+
+   return BucketValue(m_buckets.back().first);
+}
+
+std::uintmax_t QuantileSketch::Count() const noexcept
+{
+   return m_count;
+}
+
+std::int32_t QuantileSketch::BucketIndex(std::uintmax_t value) const
+{
+   return static_cast<std::int32_t>(std::ceil(std::log(static_cast<double>(value)) / m_logGamma));
+}
+
+std::uintmax_t QuantileSketch::BucketValue(std::int32_t index) const
+{
+   // The bucket with index i covers (gamma^(i - 1), gamma^i]; the value returned is the one that
+   // minimizes the relative error across that entire range:
+   const auto value = 2.0 * std::pow(m_gamma, index) / (m_gamma + 1.0);
+   return static_cast<std::uintmax_t>(std::llround(value));
+}
+
+void QuantileSketch::Collapse()
+{
+   if (m_buckets.size() <= m_maxBuckets)
+   {
+      return;
+   }
+
+   // Fold the lowest buckets into the lowest bucket that is to be retained:
+   const auto excess = m_buckets.size() - m_maxBuckets;
+
+   auto& target = m_buckets[excess];
+   for (std::size_t index{ 0 }; index < excess; ++index)
+   {
+      target.second += m_buckets[index].second;
+   }
+
+   m_buckets.erase(std::begin(m_buckets), std::next(std::begin(m_buckets), excess));
+}
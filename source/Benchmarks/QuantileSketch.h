@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+* @brief The QuantileSketch class approximates the distribution of a stream of non-negative
+* values, such as file sizes, in a fixed amount of memory.
+*
+* Values are counted in logarithmically sized buckets, so that any reported quantile is within the
+* configured relative accuracy of the true value. Once the number of buckets exceeds the
+* configured maximum, the lowest buckets are collapsed into one another, which sacrifices the
+* accuracy of the smallest values first. Two sketches built with the same parameters can be merged
+* into a sketch of the combined stream.
+*/
+class QuantileSketch
+{
+public:
+
+   /**
+   * @param[in] relativeAccuracy    The relative error that quantiles are guaranteed to be within,
+   *                                as long as no buckets have to be collapsed.
+   * @param[in] maxBuckets          The maximum number of buckets retained by the sketch.
+   */
+   QuantileSketch(
+      double relativeAccuracy,
+      std::size_t maxBuckets);
+
+   /**
+   * @returns The number of buckets that it takes to cover all values from minValue to maxValue at
+   * the specified relative accuracy, so that none of those values ever have to be collapsed.
+   */
+   static std::size_t BucketsToCover(
+      double relativeAccuracy,
+      std::uintmax_t minValue,
+      std::uintmax_t maxValue);
+
+   /**
+   * @brief Adds a single value to the sketch.
+   */
+   void Add(std::uintmax_t value);
+
+   /**
+   * @brief Adds all values counted by the other sketch to this one.
+   *
+   * @note Both sketches need to have been constructed with the same parameters.
+   */
+   void Merge(const QuantileSketch& other);
+
+   /**
+   * @param[in] quantile            The quantile to estimate, between zero and one.
+   *
+   * @returns The estimated value at the specified quantile, or zero if the sketch is empty.
+   */
+   std::uintmax_t Quantile(double quantile) const;
+
+   /**
+   * @returns The number of values that have been added to the sketch.
+   */
+   std::uintmax_t Count() const noexcept;
+
+private:
+
+   using Bucket = std::pair<std::int32_t, std::uintmax_t>;
+
+   std::int32_t BucketIndex(std::uintmax_t value) const;
+
+   std::uintmax_t BucketValue(std::int32_t index) const;
+
+   void Collapse();
+
+   // Buckets are kept sorted by index, and only buckets with a non-zero count are stored:
+   std::vector<Bucket> m_buckets;
+
+   std::uintmax_t m_zeroCount{ 0 };
+   std::uintmax_t m_count{ 0 };
+
+   double m_gamma;
+   double m_logGamma;
+
+   std::size_t m_maxBuckets;
+};
@@ -0,0 +1,70 @@
+#include "StringArena.h"
+
+#include "Utf8.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+std::string_view StringArena::Store(std::string_view text)
+{
+   if (text.empty())
+   {
+      return { };
+   }
+
+   char* const destination = Allocate(text.size());
+   std::memcpy(destination, text.data(), text.size());
+
+   return { destination, text.size() };
+}
+
+std::string_view StringArena::Store(std::wstring_view text)
+{
+   if (text.empty())
+   {
+      return { };
+   }
+
+   const auto byteCount = Utf8::EncodedLength(text);
+
+   // Only the reservation needs to happen under the lock; the encoding itself can then safely
+   // proceed in parallel with other threads storing their own strings.
+   char* const destination = Allocate(byteCount);
+   Utf8::Encode(text, destination);
+
+   return { destination, byteCount };
+}
+
+std::size_t StringArena::GetBytesReserved() const
+{
+   const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
+   return m_bytesReserved;
+}
+
+char* StringArena::Allocate(std::size_t byteCount)
+{
+   const std::lock_guard<decltype(m_mutex)> lock{ m_mutex };
+
+   if (byteCount > m_bytesRemaining)
+   {
+      // Oversized strings get a block of their own, so that the remainder of the current block
+      // isn't wasted:
+      const auto blockSize = std::max(byteCount, BLOCK_SIZE);
+      m_blocks.emplace_back(new char[blockSize]);
+      m_bytesReserved += blockSize;
+
+      if (blockSize != BLOCK_SIZE)
+      {
+         return m_blocks.back().get();
+      }
+
+      m_cursor = m_blocks.back().get();
+      m_bytesRemaining = blockSize;
+   }
+
+   char* const allocation = m_cursor;
+   m_cursor += byteCount;
+   m_bytesRemaining -= byteCount;
+
+   return allocation;
+}
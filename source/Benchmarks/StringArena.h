@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+* @brief The StringArena class owns the character data of every name recorded during a scan.
+*
+* Strings are copied into large, fixed-size blocks and handed back out as views into those
+* blocks. Nothing is ever freed individually; all memory is released at once when the arena is
+* destroyed, so the views remain valid for the lifetime of the arena.
+*/
+class StringArena
+{
+public:
+
+   static constexpr std::size_t BLOCK_SIZE{ 1024 * 1024 };
+
+   StringArena() = default;
+
+   StringArena(const StringArena&) = delete;
+   StringArena& operator=(const StringArena&) = delete;
+
+   /**
+   * @brief Copies the given UTF-8 string into the arena.
+   *
+   * @param[in] text                The string to store.
+   *
+   * @returns A view of the stored copy.
+   */
+   std::string_view Store(std::string_view text);
+
+   /**
+   * @brief Encodes the given wide string as UTF-8, directly into the arena.
+   *
+   * @param[in] text                The string to store.
+   *
+   * @returns A view of the stored UTF-8 encoding.
+   */
+   std::string_view Store(std::wstring_view text);
+
+   /**
+   * @returns The number of bytes reserved by the arena so far.
+   */
+   std::size_t GetBytesReserved() const;
+
+private:
+
+   /**
+   * @brief Carves out space for the specified number of bytes, starting a new block if
+   * necessary.
+   */
+   char* Allocate(std::size_t byteCount);
+
+   std::vector<std::unique_ptr<char[]>> m_blocks;
+
+   char* m_cursor{ nullptr };
+   std::size_t m_bytesRemaining{ 0 };
+   std::size_t m_bytesReserved{ 0 };
+
+   mutable std::mutex m_mutex;
+};
@@ -0,0 +1,120 @@
+#include "SubtreeSketches.h"
+
+#include <algorithm>
+#include <execution>
+
+namespace
+{
+   constexpr std::uintmax_t ONE_TERABYTE{ std::uintmax_t{ 1 } << 40 };
+}
+
+SubtreeSketches::Sketch::Sketch(const SketchOptions& options) :
+   sizes{ options.sizeAccuracy, options.sizeBuckets
+      ? options.sizeBuckets
+      : QuantileSketch::BucketsToCover(options.sizeAccuracy, 1, ONE_TERABYTE) },
+   extensions{ options.extensionPrecision }
+{
+}
+
+SubtreeSketches::SubtreeSketches(
+   const Tree<FileInfo>& tree,
+   const SketchOptions& options)
+{
+   // Number every directory in pre-order, and group them by depth; since a parent is always
+   // visited before its children, the depth of the parent is already known:
+   std::vector<const NodeType*> directories;
+   std::vector<std::size_t> depths;
+   std::vector<std::vector<std::size_t>> levels;
+
+   std::for_each(tree.beginPreOrder(), tree.endPreOrder(), [&] (const NodeType& node)
+   {
+      if (!node.HasChildren())
+      {
+         return;
+      }
+
+      const auto* const parent = node.GetParent();
+      const auto depth = parent ? depths[m_indices.at(parent)] + 1 : 0;
+
+      const auto index = directories.size();
+      m_indices.emplace(&node, index);
+      directories.emplace_back(&node);
+      depths.emplace_back(depth);
+
+      if (levels.size() <= depth)
+      {
+         levels.resize(depth + 1);
+      }
+
+      levels[depth].emplace_back(index);
+   });
+
+   m_sketches.reserve(directories.size());
+   for (std::size_t index{ 0 }; index < directories.size(); ++index)
+   {
+      m_sketches.emplace_back(options);
+   }
+
+   // The deepest directories only contain files, so by the time a level is processed, the
+   // sketches of all subdirectories on the level below are complete:
+   std::for_each(levels.rbegin(), levels.rend(), [&] (const std::vector<std::size_t>& level)
+   {
+      std::for_each(std::execution::par, std::begin(level), std::end(level),
+         [&] (std::size_t index)
+      {
+         auto& sketch = m_sketches[index];
+
+         const auto* child = directories[index]->GetFirstChild();
+         for (; child; child = child->GetNextSibling())
+         {
+            if (child->HasChildren())
+            {
+               const auto& childSketch = m_sketches[m_indices.at(child)];
+
+               sketch.sizes.Merge(childSketch.sizes);
+               sketch.extensions.Merge(childSketch.extensions);
+
+               continue;
+            }
+
+            const auto& file = child->GetData();
+            if (file.type != FileType::REGULAR)
+            {
+               continue;
+            }
+
+            sketch.sizes.Add(file.size);
+
+            if (file.GetExtensionId() != ExtensionTable::NO_EXTENSION)
+            {
+               sketch.extensions.Add(HyperLogLog::Hash(file.GetExtensionId()));
+            }
+         }
+      });
+   });
+}
+
+const SubtreeSketches::Sketch* SubtreeSketches::Find(const NodeType& node) const
+{
+   const auto match = m_indices.find(&node);
+   if (match == std::end(m_indices))
+   {
+      return nullptr;
+   }
+
+   return &m_sketches[match->second];
+}
+
+std::uintmax_t SubtreeSketches::SizeQuantile(
+   const NodeType& node,
+   double quantile) const
+{
+   const auto* const sketch = Find(node);
+   return sketch ? sketch->sizes.Quantile(quantile) : 0;
+}
+
+std::uint64_t SubtreeSketches::DistinctExtensions(const NodeType& node) const
+{
+   const auto* const sketch = Find(node);
+   return sketch ? sketch->extensions.Estimate() : 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../Tree/Tree.hpp"
+#include "FileInfo.hpp"
+#include "HyperLogLog.h"
+#include "QuantileSketch.h"
+
+/**
+* @brief Controls how much memory each directory's sketches may use, and thereby their accuracy.
+*/
+struct SketchOptions
+{
+   /**
+   * The relative error of file size quantiles, as long as the bucket budget isn't exceeded.
+   */
+   double sizeAccuracy{ 0.02 };
+
+   /**
+   * The maximum number of buckets in each directory's file size sketch; zero means as many as it
+   * takes to cover every size from one byte to one terabyte at the configured accuracy, which is
+   * about 700 buckets at 2%. Buckets are only stored once a file falls into them, and once the
+   * budget is exceeded, the smallest sizes lose their accuracy first.
+   */
+   std::size_t sizeBuckets{ 0 };
+
+   /**
+   * The base-two logarithm of the number of one-byte registers in each directory's distinct
+   * extension sketch.
+   */
+   std::uint8_t extensionPrecision{ 8 };
+};
+
+/**
+* @brief The SubtreeSketches class precomputes, for every directory in a file tree, approximate
+* statistics over all files underneath that directory.
+*
+* The sketches are built bottom-up, one depth level at a time, with the directories on each level
+* being processed in parallel. Each directory's sketch is the merger of the sketches of its
+* subdirectories and the files it directly contains, so that no file is visited more than once.
+*/
+class SubtreeSketches
+{
+public:
+
+   using NodeType = Tree<FileInfo>::Node;
+
+   struct Sketch
+   {
+      explicit Sketch(const SketchOptions& options);
+
+      /**
+      * The distribution of the sizes of all regular files.
+      */
+      QuantileSketch sizes;
+
+      /**
+      * The distinct extensions of all regular files that have one.
+      */
+      HyperLogLog extensions;
+   };
+
+   /**
+   * @param[in] tree                The tree to summarize. Sketches reflect the tree as it was at
+   *                                the time of construction.
+   * @param[in] options             The memory budget of each sketch.
+   */
+   SubtreeSketches(
+      const Tree<FileInfo>& tree,
+      const SketchOptions& options = { });
+
+   /**
+   * @returns The sketch of the subtree rooted at the specified directory, or nullptr if the Node
+   * has no children.
+   */
+   const Sketch* Find(const NodeType& node) const;
+
+   /**
+   * @returns The estimated file size at the specified quantile, across all files under the
+   * specified directory.
+   */
+   std::uintmax_t SizeQuantile(
+      const NodeType& node,
+      double quantile) const;
+
+   /**
+   * @returns The estimated number of distinct file extensions under the specified directory.
+   */
+   std::uint64_t DistinctExtensions(const NodeType& node) const;
+
+private:
+
+   std::vector<Sketch> m_sketches;
+   std::unordered_map<const NodeType*, std::size_t> m_indices;
+};
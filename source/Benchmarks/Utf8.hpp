@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Utf8
+{
+   /**
+   * @brief Decodes the code point that starts at the given position of a wide string.
+   *
+   * On platforms where `wchar_t` is two bytes wide the string is treated as UTF-16, and surrogate
+   * pairs are combined; otherwise, each `wchar_t` is taken to be a UTF-32 code point. Unpaired
+   * surrogates are passed through as is, so that no file name is ever lost.
+   *
+   * @param[in] text                The wide string.
+   * @param[in, out] index          The position to decode at; advanced past the code point.
+   *
+   * @returns The decoded code point.
+   */
+   inline std::uint32_t DecodeCodePoint(std::wstring_view text, std::size_t& index) noexcept
+   {
+      auto codePoint = static_cast<std::uint32_t>(text[index++]);
+
+      if constexpr (sizeof(wchar_t) == 2)
+      {
+         const bool isHighSurrogate = codePoint >= 0xD800 && codePoint <= 0xDBFF;
+         if (isHighSurrogate && index < text.size())
+         {
+            const auto lowSurrogate = static_cast<std::uint32_t>(text[index]);
+            if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF)
+            {
+               codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+               ++index;
+            }
+         }
+      }
+
+      return codePoint;
+   }
+
+   /**
+   * @returns The number of bytes needed to encode the given code point as UTF-8.
+   */
+   constexpr std::size_t EncodedLength(std::uint32_t codePoint) noexcept
+   {
+      return codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+   }
+
+   /**
+   * @returns The number of bytes needed to encode the given wide string as UTF-8.
+   */
+   inline std::size_t EncodedLength(std::wstring_view text) noexcept
+   {
+      std::size_t length{ 0 };
+
+      std::size_t index{ 0 };
+      while (index < text.size())
+      {
+         length += EncodedLength(DecodeCodePoint(text, index));
+      }
+
+      return length;
+   }
+
+   /**
+   * @brief Encodes the given wide string as UTF-8.
+   *
+   * @param[in] text                The wide string to encode.
+   * @param[out] destination        The output buffer. This buffer has to be large enough to hold
+   *                                `EncodedLength(text)` bytes; no null terminator is written.
+   *
+   * @returns A pointer one past the last byte written.
+   */
+   inline char* Encode(std::wstring_view text, char* destination) noexcept
+   {
+      std::size_t index{ 0 };
+      while (index < text.size())
+      {
+         const auto codePoint = DecodeCodePoint(text, index);
+
+         switch (EncodedLength(codePoint))
+         {
+            case 1:
+               *destination++ = static_cast<char>(codePoint);
+               break;
+            case 2:
+               *destination++ = static_cast<char>(0xC0 | (codePoint >> 6));
+               *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+               break;
+            case 3:
+               *destination++ = static_cast<char>(0xE0 | (codePoint >> 12));
+               *destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+               *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+               break;
+            default:
+               *destination++ = static_cast<char>(0xF0 | (codePoint >> 18));
+               *destination++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+               *destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+               *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+               break;
+         }
+      }
+
+      return destination;
+   }
+
+   /**
+   * @brief Decodes the code point that starts at the given position of a UTF-8 string.
+   *
+   * This is the inverse of the encoding above, so surrogates that were passed through unpaired
+   * come back out unchanged. Malformed sequences, which Encode never produces, decode to U+FFFD.
+   *
+   * @param[in] text                The UTF-8 string.
+   * @param[in, out] index          The position to decode at; advanced past the code point.
+   *
+   * @returns The decoded code point.
+   */
+   inline std::uint32_t DecodeCodePoint(std::string_view text, std::size_t& index) noexcept
+   {
+      constexpr std::uint32_t REPLACEMENT_CHARACTER{ 0xFFFD };
+
+      const auto leadByte = static_cast<unsigned char>(text[index++]);
+      if (leadByte < 0x80)
+      {
+         return leadByte;
+      }
+
+      std::size_t continuationBytes{ 0 };
+      std::uint32_t codePoint{ 0 };
+
+      if ((leadByte & 0xE0) == 0xC0)
+      {
+         continuationBytes = 1;
+         codePoint = leadByte & 0x1F;
+      }
+      else if ((leadByte & 0xF0) == 0xE0)
+      {
+         continuationBytes = 2;
+         codePoint = leadByte & 0x0F;
+      }
+      else if ((leadByte & 0xF8) == 0xF0)
+      {
+         continuationBytes = 3;
+         codePoint = leadByte & 0x07;
+      }
+      else
+      {
+         return REPLACEMENT_CHARACTER;
+      }
+
+      for (; continuationBytes > 0; --continuationBytes)
+      {
+         if (index == text.size()
+            || (static_cast<unsigned char>(text[index]) & 0xC0) != 0x80)
+         {
+            return REPLACEMENT_CHARACTER;
+         }
+
+         codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F);
+      }
+
+      return codePoint;
+   }
+
+   /**
+   * @brief Decodes the given UTF-8 string into a wide string.
+   *
+   * On platforms where `wchar_t` is two bytes wide, code points outside of the Basic Multilingual
+   * Plane are split into surrogate pairs again; otherwise, each code point becomes one `wchar_t`.
+   *
+   * @param[in] text                The UTF-8 string to decode.
+   *
+   * @returns The wide string that Encode would turn into the given UTF-8 string.
+   */
+   inline std::wstring Decode(std::string_view text)
+   {
+      std::wstring result;
+      result.reserve(text.size());
+
+      std::size_t index{ 0 };
+      while (index < text.size())
+      {
+         auto codePoint = DecodeCodePoint(text, index);
+
+         if constexpr (sizeof(wchar_t) == 2)
+         {
+            if (codePoint >= 0x10000)
+            {
+               codePoint -= 0x10000;
+               result.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+               result.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+
+               continue;
+            }
+         }
+
+         result.push_back(static_cast<wchar_t>(codePoint));
+      }
+
+      return result;
+   }
+}
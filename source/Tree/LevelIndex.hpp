@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Tree.hpp"
+
+/**
+* @brief The LevelIndex class groups the nodes of a read-only Tree by their depth, so that all nodes
+* on a given level can be visited in time proportional to the width of that level.
+*
+* Levels are gathered lazily and top-down: requesting a level gathers it, along with any levels
+* above it that haven't been gathered yet, from the children of the level above. Showing the top
+* few levels of a Tree therefore never touches any of the Nodes below them.
+*
+* Within each level, the nodes appear in level-order, which means that the children of a node are
+* contiguous, and appear in the same order as the nodes on the level above.
+*
+* @note The index is a snapshot; any structural changes made to the Tree after a level was gathered
+* are not reflected in it. To catch those, the index records the child list version of every Node
+* whose children it gathered, and IsStale() compares these against the Tree; Level() asserts that
+* the index hasn't gone stale.
+*/
+template<typename TreeType>
+class LevelIndex
+{
+public:
+
+   using NodeType = typename TreeType::Node;
+
+   /**
+   * @param[in] tree                The Tree to index. Only its root is looked at until any deeper
+   *                                levels are requested.
+   */
+   explicit LevelIndex(const TreeType& tree) :
+      m_tree{ &tree }
+   {
+      auto& root = m_levels.emplace_back();
+      if (tree.GetRoot())
+      {
+         root.emplace_back(tree.GetRoot());
+      }
+   }
+
+   /**
+   * @returns All nodes at the specified depth, in level-order; the list is empty if the Tree isn't
+   * that deep.
+   *
+   * @complexity Linear in the number of nodes on the requested level, plus the number of nodes on
+   * all levels above it that haven't been requested before.
+   */
+   const std::vector<NodeType*>& Level(std::size_t depth)
+   {
+      assert(!IsStale());
+
+      while (m_levels.size() <= depth && !m_levels.back().empty())
+      {
+         GatherNextLevel();
+      }
+
+      return depth < m_levels.size() ? m_levels[depth] : m_levels.back();
+   }
+
+   /**
+   * @returns True if the structure of the Tree has changed since any of the levels were gathered,
+   * in which case the index has to be rebuilt; false otherwise.
+   *
+   * @complexity Linear in the number of nodes on all levels gathered so far, save the deepest.
+   */
+   bool IsStale() const noexcept
+   {
+      const auto& root = m_levels.front();
+      if (m_tree->GetRoot() != (root.empty() ? nullptr : root.front()))
+      {
+         return true;
+      }
+
+      // The levels are checked top-down, so that the Nodes on a level are only looked at once the
+      // child lists that they were gathered from are known to be intact, and thus still alive:
+      for (std::size_t depth{ 0 }; depth < m_childListVersions.size(); ++depth)
+      {
+         const auto& level = m_levels[depth];
+         const auto& versions = m_childListVersions[depth];
+
+         for (std::size_t index{ 0 }; index < level.size(); ++index)
+         {
+            if (level[index]->GetChildListVersion() != versions[index])
+            {
+               return true;
+            }
+         }
+      }
+
+      return false;
+   }
+
+   /**
+   * @returns The number of levels gathered so far, including an empty level if the bottom of the
+   * Tree has been reached.
+   */
+   std::size_t GatheredLevelCount() const noexcept
+   {
+      return m_levels.size();
+   }
+
+   /**
+   * @returns The number of nodes on all levels gathered so far.
+   */
+   std::size_t GatheredNodeCount() const noexcept
+   {
+      std::size_t count{ 0 };
+      for (const auto& level : m_levels)
+      {
+         count += level.size();
+      }
+
+      return count;
+   }
+
+private:
+
+   void GatherNextLevel()
+   {
+      std::size_t width{ 0 };
+      for (const auto* node : m_levels.back())
+      {
+         width += node->GetChildCount();
+      }
+
+      std::vector<NodeType*> nextLevel;
+      nextLevel.reserve(width);
+
+      auto& versions = m_childListVersions.emplace_back();
+      versions.reserve(m_levels.back().size());
+
+      for (const auto* node : m_levels.back())
+      {
+         versions.emplace_back(node->GetChildListVersion());
+
+         for (auto* child = node->GetFirstChild(); child; child = child->GetNextSibling())
+         {
+            nextLevel.emplace_back(child);
+         }
+      }
+
+      assert(nextLevel.size() == width);
+      m_levels.emplace_back(std::move(nextLevel));
+   }
+
+   const TreeType* m_tree{ nullptr };
+
+   std::vector<std::vector<NodeType*>> m_levels;
+
+   // The child list versions of the Nodes on every level that the next level was gathered from:
+   std::vector<std::vector<std::uint16_t>> m_childListVersions;
+};
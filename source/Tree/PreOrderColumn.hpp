@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <execution>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Tree.hpp"
+
+/**
+* @brief The PreOrderColumn class lays out one numeric field of a read-only Tree in pre-order, and
+* builds a prefix-sum array over it.
+*
+* Since every subtree occupies a contiguous range in pre-order, the sum over any subtree, as well
+* as its node count, then comes down to two lookups, instead of a traversal of the subtree.
+*
+* Queries are keyed on the pre-order position of a node, which lines up with a pre-order
+* traversal, and with the values returned by Tree::ParallelFoldUp. The end of each subtree is kept
+* in an array indexed by that same position. Queries keyed on the nodes themselves are only
+* available when the column is built with NodeLookup::ENABLED, which costs a hash table entry per
+* node.
+*
+* @note The column is a snapshot; any structural or data changes made to the Tree after the column
+* was built are not reflected in it.
+*/
+template<
+   typename TreeType,
+   typename ValueType
+>
+class PreOrderColumn
+{
+public:
+
+   using NodeType = typename TreeType::Node;
+
+   /**
+   * @brief Whether the column should also be queryable by node, rather than only by position.
+   */
+   enum class NodeLookup
+   {
+      DISABLED,
+      ENABLED
+   };
+
+   /**
+   * @brief Builds the column in a single pre-order pass over the Tree, after which the prefix sums
+   * are computed with a vectorized, parallel scan.
+   *
+   * @param[in] tree                The Tree to lay out.
+   * @param[in] extractor           A callable type that extracts the value of a node. This type
+   *                                should be equivalent to:
+   *                                   ValueType extractor(const Node& node);
+   * @param[in] nodeLookup          Whether the position of each node should be recorded, so that
+   *                                the column can also be queried by node.
+   */
+   template<typename ExtractorType>
+   PreOrderColumn(
+      const TreeType& tree,
+      const ExtractorType& extractor,
+      NodeLookup nodeLookup = NodeLookup::DISABLED)
+   {
+      std::vector<ValueType> values;
+
+      // The subtree of a node ends where the first node that isn't one of its descendants
+      // begins, which is tracked by keeping the path from the root to the current node:
+      std::vector<std::pair<const NodeType*, std::size_t>> openNodes;
+
+      std::for_each(tree.beginPreOrder(), tree.endPreOrder(), [&] (const NodeType& node)
+      {
+         const auto position = values.size();
+
+         while (!openNodes.empty() && openNodes.back().first != node.GetParent())
+         {
+            m_subtreeEnds[openNodes.back().second] = position;
+            openNodes.pop_back();
+         }
+
+         openNodes.emplace_back(&node, position);
+         m_subtreeEnds.emplace_back(position + 1);
+
+         if (nodeLookup == NodeLookup::ENABLED)
+         {
+            m_positions.emplace(&node, position);
+         }
+
+         values.emplace_back(extractor(node));
+      });
+
+      for (const auto& openNode : openNodes)
+      {
+         m_subtreeEnds[openNode.second] = values.size();
+      }
+
+      m_prefixSums.resize(values.size() + 1);
+      m_prefixSums.front() = ValueType{ };
+
+      std::inclusive_scan(std::execution::par_unseq,
+         std::begin(values), std::end(values), std::next(std::begin(m_prefixSums)));
+   }
+
+   /**
+   * @returns The sum of the values of all nodes in the subtree rooted at the node at the specified
+   * pre-order position, including that node itself.
+   *
+   * @complexity Constant.
+   */
+   ValueType SubtreeSum(std::size_t position) const
+   {
+      return m_prefixSums[SubtreeEnd(position)] - m_prefixSums[position];
+   }
+
+   /**
+   * @returns The number of nodes in the subtree rooted at the node at the specified pre-order
+   * position, including that node itself.
+   *
+   * @complexity Constant.
+   */
+   std::size_t SubtreeCount(std::size_t position) const
+   {
+      return SubtreeEnd(position) - position;
+   }
+
+   /**
+   * @returns The pre-order position just past the subtree rooted at the node at the specified
+   * position. If that node has a next sibling, this is the position of that sibling.
+   *
+   * @complexity Constant.
+   */
+   std::size_t SubtreeEnd(std::size_t position) const
+   {
+      assert(position < m_subtreeEnds.size());
+      return m_subtreeEnds[position];
+   }
+
+   /**
+   * @returns The pre-order position of the specified Node.
+   *
+   * @note Only available if the column was built with NodeLookup::ENABLED.
+   */
+   std::size_t Position(const NodeType& node) const
+   {
+      const auto match = m_positions.find(&node);
+      assert(match != std::end(m_positions));
+
+      return match->second;
+   }
+
+   /**
+   * @overload
+   *
+   * @note Only available if the column was built with NodeLookup::ENABLED.
+   */
+   ValueType SubtreeSum(const NodeType& node) const
+   {
+      return SubtreeSum(Position(node));
+   }
+
+   /**
+   * @overload
+   *
+   * @note Only available if the column was built with NodeLookup::ENABLED.
+   */
+   std::size_t SubtreeCount(const NodeType& node) const
+   {
+      return SubtreeCount(Position(node));
+   }
+
+   /**
+   * @returns The sum of the values of all nodes in the Tree.
+   */
+   ValueType Total() const noexcept
+   {
+      return m_prefixSums.back();
+   }
+
+   /**
+   * @returns The number of nodes in the column.
+   */
+   std::size_t Size() const noexcept
+   {
+      return m_prefixSums.size() - 1;
+   }
+
+private:
+
+   std::vector<ValueType> m_prefixSums;
+   std::vector<std::size_t> m_subtreeEnds;
+
+   std::unordered_map<const NodeType*, std::size_t> m_positions;
+};
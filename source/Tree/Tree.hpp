@@ -25,1195 +25,5010 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <execution>
+#include <functional>
 #include <iterator>
-
-/**
-* The Tree class declares a basic tree, built on top of templatized Node nodes.
-*
-* Each tree consists of a simple root Node and nothing else.
-*/
-template<typename DataType>
-class Tree
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+namespace TreeInternals
 {
-public:
-
-   class Node;
-
-   class Iterator;
-   class PreOrderIterator;
-   class PostOrderIterator;
-   class LeafIterator;
-   class SiblingIterator;
-
-   // Typedefs needed for STL compliance:
-   using value_type = Node;
-   using reference = Node&;
-   using const_reference = const Node&;
-
    /**
-   * @brief Default constructor.
+   * @brief Hints to the processor that the cache line holding the specified address will soon be
+   * read, so that the load can overlap with whatever work precedes it.
    */
-   Tree() :
-      m_root{ new Node{ } }
+   inline void Prefetch(const void* address) noexcept
    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(address);
+#else
+      (void)address;
+#endif
    }
 
    /**
-   * @brief Tree constructs a new Tree with the provided data encapsulated in a new
-   * Node.
+   * @brief The default aggregate policy, under which nodes don't maintain any aggregate at all.
    */
-   Tree(DataType data) :
-      m_root{ new Node{ data } }
+   struct NoAggregate
    {
-   }
+   };
 
    /**
-   * @brief Copy constructor.
+   * @brief Whether the specified aggregate policy can undo a Combine operation, which allows
+   * removals to be propagated as deltas.
    */
-   Tree(const Tree<DataType>& other) :
-      m_root{ new Node{ *other.m_root } }
-   {
-   }
+   template<
+      typename PolicyType,
+      typename = void
+   >
+   constexpr bool IsInvertible = false;
 
-   /**
-   * @brief Assignment operator.
-   */
-   Tree<DataType>& operator=(Tree<DataType> other)
-   {
-      swap(*this, other);
-      return *this;
-   }
+   template<typename PolicyType>
+   constexpr bool IsInvertible<PolicyType, std::void_t<decltype(PolicyType::Subtract(
+      std::declval<const typename PolicyType::ValueType&>(),
+      std::declval<const typename PolicyType::ValueType&>()))>> = true;
 
    /**
-   * @brief Swaps all member variables of the left-hand side with that of the right-hand side.
+   * @brief The AggregateStorage class holds the aggregate of a Node's subtree.
    */
-   friend void swap(
-      Tree<DataType>& lhs,
-      Tree<DataType>& rhs) noexcept(noexcept(swap(lhs.m_root, rhs.m_root)))
+   template<
+      typename PolicyType,
+      typename DataType
+   >
+   class AggregateStorage
    {
-      // Enable Argument Dependent Lookup (ADL):
-      using std::swap;
+   protected:
 
-      swap(lhs.m_root, rhs.m_root);
-   }
+      AggregateStorage() :
+         m_aggregate{ PolicyType::Lift(DataType{ }) }
+      {
+      }
 
-   /**
-   * @brief Deletes the root Node, which, in turn, will trigger a deletion of every
-   * Node in the Tree.
-   */
-   ~Tree()
-   {
-      delete m_root;
-   }
+      explicit AggregateStorage(const DataType& data) :
+         m_aggregate{ PolicyType::Lift(data) }
+      {
+      }
 
-   /**
-   * @returns A pointer to the root Node.
-   */
-   inline Node* GetRoot() const noexcept
-   {
-      return m_root;
-   }
+      typename PolicyType::ValueType m_aggregate;
+   };
 
    /**
-   * @brief Computes the number of nodes in the Tree.
-   *
-   * @complexity Linear in the size of the Tree.
-   *
-   * @returns The total number of nodes in the Tree. This includes leaf and non-leaf nodes,
-   * in addition to the root node.
+   * @brief Nodes without an aggregate policy don't pay for any aggregate storage.
    */
-   inline auto Size() const noexcept
+   template<typename DataType>
+   class AggregateStorage<NoAggregate, DataType>
    {
-      return std::count_if(std::begin(*this), std::end(*this),
-         [] (const auto&) noexcept
-      {
-         return true;
-      });
-   }
+   protected:
 
-   /**
-   * @returns The zero-indexed depth of the Node in its Tree.
-   */
-   static unsigned int Depth(const Node& node) noexcept
-   {
-      unsigned int depth = 0;
+      constexpr AggregateStorage() noexcept = default;
 
-      const Node* nodePtr = &node;
-      while (nodePtr->GetParent())
+      explicit constexpr AggregateStorage(const DataType&) noexcept
       {
-         ++depth;
-         nodePtr = nodePtr->GetParent();
       }
-
-      return depth;
-   }
+   };
 
    /**
-   * @returns A pre-order iterator that will iterate over all Nodes in the tree.
+   * @brief The LeafLinks class threads a Node onto the doubly-linked list of all leaves in its
+   * Tree, on top of whatever other per-Node storage the Tree requires.
    */
-   inline typename Tree::PreOrderIterator beginPreOrder() const noexcept
+   template<
+      bool IsThreaded,
+      typename NodeType,
+      typename BaseType
+   >
+   class LeafLinks : public BaseType
    {
-      const auto iterator = Tree<DataType>::PreOrderIterator{ m_root };
-      return iterator;
-   }
+   protected:
 
-   /**
-   * @returns A pre-order iterator pointing "past" the end of the tree.
-   */
-   inline typename Tree::PreOrderIterator endPreOrder() const noexcept
-   {
-      const auto iterator = Tree<DataType>::PreOrderIterator{ nullptr };
-      return iterator;
-   }
+      using BaseType::BaseType;
+
+      NodeType* m_previousLeaf{ nullptr };
+      NodeType* m_nextLeaf{ nullptr };
+   };
 
    /**
-   * @returns A post-order iterator that will iterator over all nodes in the tree, starting
-   * with the root of the Tree.
+   * @brief Nodes of Trees without a threaded leaf list don't pay for the links.
    */
-   inline typename Tree::PostOrderIterator begin() const noexcept
+   template<
+      typename NodeType,
+      typename BaseType
+   >
+   class LeafLinks<false, NodeType, BaseType> : public BaseType
    {
-      const auto iterator = Tree<DataType>::PostOrderIterator{ m_root };
-      return iterator;
-   }
+   protected:
+
+      using BaseType::BaseType;
+   };
 
    /**
-   * @returns A post-order iterator that points past the end of the Tree.
+   * @brief Whether sort keys of the specified type can be radix sorted.
    */
-   inline typename Tree::PostOrderIterator end() const noexcept
-   {
-      const auto iterator = Tree<DataType>::PostOrderIterator{ nullptr };
-      return iterator;
-   }
+   template<typename KeyType>
+   constexpr bool IsRadixSortable =
+      std::is_integral_v<KeyType> && !std::is_same_v<KeyType, bool>;
 
    /**
-   * @returns An iterator that will iterator over all leaf nodes in the Tree, starting with the
-   * left-most leaf in the Tree.
+   * @brief Maps an integral key onto an unsigned key with the same relative ordering.
    */
-   inline typename Tree::LeafIterator beginLeaf() const noexcept
+   template<typename KeyType>
+   inline constexpr auto ToRadixKey(KeyType key) noexcept
    {
-      const auto iterator = Tree<DataType>::LeafIterator{ m_root };
-      return iterator;
+      using UnsignedType = std::make_unsigned_t<KeyType>;
+
+      if constexpr (std::is_signed_v<KeyType>)
+      {
+         constexpr auto signBit = UnsignedType{ 1 } << (sizeof(KeyType) * 8 - 1);
+         return static_cast<UnsignedType>(static_cast<UnsignedType>(key) ^ signBit);
+      }
+      else
+      {
+         return key;
+      }
    }
 
    /**
-   * @return A LeafIterator that points past the last leaf Node in the Tree.
+   * @brief Performs a stable, least-significant-digit radix sort of the specified entries, one
+   * byte at a time. Passes over bytes on which all keys agree are skipped.
+   *
+   * @param[in, out] entries        The (unsigned key, value) pairs to be sorted by key.
    */
-   inline typename Tree::LeafIterator endLeaf() const noexcept
+   template<
+      typename KeyType,
+      typename ValueType
+   >
+   void RadixSort(std::vector<std::pair<KeyType, ValueType>>& entries)
    {
-      const auto iterator = Tree<DataType>::LeafIterator{ nullptr };
-      return iterator;
-   }
+      static_assert(std::is_unsigned_v<KeyType>, "Radix keys need to be unsigned.");
 
-private:
+      constexpr auto RADIX{ 256u };
+      constexpr auto BYTE_COUNT{ sizeof(KeyType) };
 
-   Node* m_root{ nullptr };
-};
+      if (entries.size() < 2)
+      {
+         return;
+      }
 
-/**
-* The Node class represents the nodes that make up the Tree.
-*
-* Each node has a pointer to its parent, its first and last child, its previous and next
-* sibling, and, of course, to the data it encapsulates.
-*/
-template<typename DataType>
-class Tree<DataType>::Node
-{
-public:
+      std::array<std::array<std::size_t, RADIX>, BYTE_COUNT> histograms{ };
 
-   // Typedefs needed for STL compliance:
-   using value_type = DataType;
-   using reference = DataType&;
-   using const_reference = const DataType&;
+      for (const auto& entry : entries)
+      {
+         for (std::size_t byte{ 0 }; byte < BYTE_COUNT; ++byte)
+         {
+            ++histograms[byte][(entry.first >> (byte * 8)) & (RADIX - 1)];
+         }
+      }
 
-   /**
-   * @brief Node default constructs a new Node. All outgoing links from this new node will
-   * initialized to a nullptr.
-   */
-   constexpr Node() noexcept = default;
+      std::vector<std::pair<KeyType, ValueType>> scratch(entries.size());
 
-   /**
-   * @brief Node constructs a new Node encapsulating the specified data. All outgoing links
-   * from the node will be initialized to nullptr.
-   */
-   Node(DataType data) :
-      m_data{ std::move(data) }
-   {
-   }
+      for (std::size_t byte{ 0 }; byte < BYTE_COUNT; ++byte)
+      {
+         auto& histogram = histograms[byte];
 
-   /**
-   * @brief Node performs a copy-construction of the specified Node.
-   *
-   * The nodes in the Node are deep-copied, while the data contained in the tree is
-   * shallow-copied.
-   */
-   Node(const Node& other) :
-      m_data{ other.m_data }
-   {
-      Copy(other, *this);
+         const auto firstDigit = (entries.front().first >> (byte * 8)) & (RADIX - 1);
+         if (histogram[firstDigit] == entries.size())
+         {
+            continue;
+         }
+
+         std::size_t offset{ 0 };
+         for (auto& count : histogram)
+         {
+            offset += std::exchange(count, offset);
+         }
+
+         for (const auto& entry : entries)
+         {
+            scratch[histogram[(entry.first >> (byte * 8)) & (RADIX - 1)]++] = entry;
+         }
+
+         entries.swap(scratch);
+      }
    }
 
    /**
-   * @brief Destroys the Node and all Nodes under it.
+   * @brief The BoundedHeap class retains the entries with the largest keys out of all entries
+   * offered to it, while never holding more than a fixed number of entries.
    */
-   ~Node()
+   template<
+      typename KeyType,
+      typename ValueType
+   >
+   class BoundedHeap
    {
-      DetachFromTree();
+   public:
 
-      if (m_childCount == 0)
+      /**
+      * @param[in] capacity         The maximum number of entries to retain.
+      */
+      explicit BoundedHeap(std::size_t capacity) :
+         m_capacity{ capacity }
       {
-         m_parent = nullptr;
-         m_firstChild = nullptr;
-         m_lastChild = nullptr;
-         m_previousSibling = nullptr;
-         m_nextSibling = nullptr;
+      }
 
-         return;
+      /**
+      * @brief Offers an entry to the heap, which is only retained if its key is among the largest
+      * keys seen so far.
+      */
+      void Offer(KeyType key, ValueType value)
+      {
+         if (m_entries.size() < m_capacity)
+         {
+            m_entries.emplace_back(std::move(key), std::move(value));
+            std::push_heap(std::begin(m_entries), std::end(m_entries), IsGreater);
+
+            return;
+         }
+
+         if (m_capacity == 0 || !(m_entries.front().first < key))
+         {
+            return;
+         }
+
+         std::pop_heap(std::begin(m_entries), std::end(m_entries), IsGreater);
+         m_entries.back() = { std::move(key), std::move(value) };
+         std::push_heap(std::begin(m_entries), std::end(m_entries), IsGreater);
       }
 
-      assert(m_firstChild && m_lastChild);
+      /**
+      * @brief Offers all entries retained by another heap to this one.
+      */
+      void Merge(BoundedHeap&& other)
+      {
+         for (auto& entry : other.m_entries)
+         {
+            Offer(std::move(entry.first), std::move(entry.second));
+         }
 
-      Node* childNode = m_firstChild;
-      Node* nextNode = nullptr;
+         other.m_entries.clear();
+      }
 
-      while (childNode != nullptr)
+      /**
+      * @returns The retained entries, ordered from the largest key to the smallest. The heap is
+      * left empty.
+      */
+      std::vector<std::pair<KeyType, ValueType>> Extract()
       {
-         nextNode = childNode->m_nextSibling;
-         delete childNode;
-         childNode = nextNode;
+         std::sort_heap(std::begin(m_entries), std::end(m_entries), IsGreater);
+         return std::move(m_entries);
       }
 
-      m_parent = nullptr;
-      m_firstChild = nullptr;
-      m_lastChild = nullptr;
-      m_previousSibling = nullptr;
-      m_nextSibling = nullptr;
-   }
+   private:
 
-   /**
-   * @brief Assignment operator.
-   */
-   Node& operator=(Node other)
-   {
-      swap(*this, other);
-      return *this;
-   }
+      static bool IsGreater(
+         const std::pair<KeyType, ValueType>& lhs,
+         const std::pair<KeyType, ValueType>& rhs)
+      {
+         return rhs.first < lhs.first;
+      }
+
+      std::size_t m_capacity;
+      std::vector<std::pair<KeyType, ValueType>> m_entries;
+   };
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is less than
-   * the data encapsulated in the right-hand side Node.
+   * @brief Estimates the number of nodes in a subtree without visiting all of them (Knuth's
+   * estimator): each probe descends along a random path, and sums the products of the branching
+   * factors encountered along the way. The estimate is unbiased, and a probe only ever touches
+   * the children of the Nodes on its path.
    */
-   friend auto operator<(const Node& lhs, const Node& rhs)
+   template<
+      typename NodeType,
+      typename GeneratorType
+   >
+   double EstimateSubtreeSize(
+      const NodeType& root,
+      unsigned int probeCount,
+      GeneratorType& generator)
    {
-      return lhs.GetData() < rhs.GetData();
+      double total{ 0 };
+
+      for (unsigned int probe{ 0 }; probe < probeCount; ++probe)
+      {
+         double estimate{ 1 };
+         double nodesOnLevel{ 1 };
+
+         for (const NodeType* node = &root; node->HasChildren(); )
+         {
+            const auto childCount = node->GetChildCount();
+
+            nodesOnLevel *= childCount;
+            estimate += nodesOnLevel;
+
+            std::uniform_int_distribution<unsigned int> pickChild{ 0, childCount - 1 };
+
+            auto index = pickChild(generator);
+            for (node = node->GetFirstChild(); index > 0; --index)
+            {
+               node = node->GetNextSibling();
+            }
+         }
+
+         total += estimate;
+      }
+
+      return probeCount ? total / probeCount : 1.0;
    }
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is less than
-   * or equal to the data encapsulated in the right-hand side Node.
+   * @brief A fixed set of tasks, divided among the queues of a number of workers.
+   *
+   * Each worker takes tasks from the front of its own queue; once that runs dry, it steals from
+   * the back of the queues of the other workers, so that nobody sits idle while tasks remain.
+   * Since no tasks are added after the workers have started, a worker that finds every queue empty
+   * is done.
    */
-   friend auto operator<=(const Node& lhs, const Node& rhs)
+   template<typename TaskType>
+   class WorkStealingQueues
    {
-      return !(lhs > rhs);
-   }
+   public:
+
+      explicit WorkStealingQueues(std::size_t workerCount) :
+         m_queues(std::max<std::size_t>(workerCount, 1))
+      {
+      }
+
+      /**
+      * @brief Appends the task to the back of the specified worker's queue.
+      */
+      void Push(
+         std::size_t worker,
+         TaskType task)
+      {
+         auto& queue = m_queues[worker];
+
+         const std::lock_guard<std::mutex> lock{ queue.mutex };
+         queue.tasks.emplace_back(std::move(task));
+      }
+
+      /**
+      * @brief Takes the next task for the specified worker, stealing one if its own queue is empty.
+      *
+      * @returns False if there are no tasks left anywhere.
+      */
+      bool Pop(
+         std::size_t worker,
+         TaskType& task)
+      {
+         if (Take(m_queues[worker], task, /* fromFront = */ true))
+         {
+            return true;
+         }
+
+         for (std::size_t offset{ 1 }; offset < m_queues.size(); ++offset)
+         {
+            auto& victim = m_queues[(worker + offset) % m_queues.size()];
+            if (Take(victim, task, /* fromFront = */ false))
+            {
+               return true;
+            }
+         }
+
+         return false;
+      }
+
+   private:
+
+      struct Queue
+      {
+         std::mutex mutex;
+         std::deque<TaskType> tasks;
+      };
+
+      static bool Take(
+         Queue& queue,
+         TaskType& task,
+         bool fromFront)
+      {
+         const std::lock_guard<std::mutex> lock{ queue.mutex };
+         if (queue.tasks.empty())
+         {
+            return false;
+         }
+
+         if (fromFront)
+         {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+         }
+         else
+         {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+         }
+
+         return true;
+      }
+
+      std::vector<Queue> m_queues;
+   };
+
+   /**
+   * @brief The result of folding a single subtree: the value of its root, and the number of Nodes
+   * that the subtree holds.
+   */
+   template<typename ValueType>
+   struct FoldedSubtree
+   {
+      ValueType value;
+      std::size_t size;
+   };
+
+   /**
+   * @brief A run of consecutive siblings, from first to last, whose subtrees make up a single task.
+   * Since the subtrees of consecutive siblings follow one another in pre-order, a run also covers a
+   * contiguous stretch of a pre-order traversal.
+   */
+   template<typename NodeType>
+   struct SiblingRange
+   {
+      /**
+      * @brief Invokes the function on each Node in the run, from first to last.
+      */
+      template<typename FunctionType>
+      void ForEach(FunctionType&& function) const
+      {
+         for (auto* node = first; ; node = node->GetNextSibling())
+         {
+            function(*node);
+
+            if (node == last)
+            {
+               return;
+            }
+         }
+      }
+
+      NodeType* first;
+      NodeType* last;
+   };
+
+   /**
+   * @brief Divides the subtree rooted at the specified Node into smaller subtrees that can be
+   * processed independently. The subtree with the largest estimated size is repeatedly split up
+   * into the subtrees of its children, until every subtree is small enough, or until there are
+   * enough tasks. Consecutive children whose subtrees are small are grouped into a single task, so
+   * that a Node with many small children doesn't turn into as many tasks.
+   *
+   * @param[in] root                The root of the subtree to divide.
+   * @param[in] taskCount           The number of tasks to aim for.
+   * @param[in] grainSize           Subtrees estimated to be no larger than this aren't split up.
+   * @param[in] onSplit             Invoked on the root of every subtree that is split up, in the
+   *                                order in which they are split, which has parents before their
+   *                                children.
+   *
+   * @returns The resulting tasks, with the largest estimated task first. If the subtree isn't worth
+   * dividing, that is the root itself.
+   */
+   template<
+      typename NodeType,
+      typename SplitCallbackType
+   >
+   std::vector<SiblingRange<NodeType>> DivideIntoTasks(
+      NodeType& root,
+      std::size_t taskCount,
+      std::size_t grainSize,
+      SplitCallbackType&& onSplit)
+   {
+      // A fixed seed keeps the division of the work, though not the timing, reproducible:
+      constexpr unsigned int PROBES_PER_SUBTREE{ 4 };
+      std::minstd_rand generator;
+
+      if (taskCount <= 1)
+      {
+         return { SiblingRange<NodeType>{ &root, &root } };
+      }
+
+      // Splitting a Node requires the estimated sizes of all of its children anyway, and summing
+      // those is both cheaper and more precise than probing a Node with many children directly.
+      // The children are collected along the way, so that they're only chased down once:
+      std::vector<std::pair<NodeType*, double>> children;
+      const auto estimateChildren = [&] (NodeType& node)
+      {
+         children.clear();
+         children.reserve(node.GetChildCount());
+
+         double size{ 1 };
+         for (auto* child = node.GetFirstChild(); child; child = child->GetNextSibling())
+         {
+            const auto childSize = child->HasChildren()
+               ? EstimateSubtreeSize(*child, PROBES_PER_SUBTREE, generator)
+               : 1.0;
+
+            children.emplace_back(child, childSize);
+            size += childSize;
+         }
+
+         return size;
+      };
+
+      const auto rootSize = estimateChildren(root);
+      if (rootSize <= static_cast<double>(grainSize))
+      {
+         return { SiblingRange<NodeType>{ &root, &root } };
+      }
+
+      const auto taskSize = std::max(
+         rootSize / static_cast<double>(taskCount), static_cast<double>(grainSize));
+
+      using TaskType = std::pair<double, SiblingRange<NodeType>>;
+      const auto isSmaller = [] (const TaskType& lhs, const TaskType& rhs) noexcept
+      {
+         return lhs.first < rhs.first;
+      };
+
+      std::priority_queue<TaskType, std::vector<TaskType>, decltype(isSmaller)> tasks{ isSmaller };
+      tasks.emplace(rootSize, SiblingRange<NodeType>{ &root, &root });
+
+      // A run of siblings never grows beyond the size of a task, so only runs of a single Node are
+      // ever large enough to be split:
+      while (!tasks.empty() && tasks.top().first > taskSize && tasks.size() < taskCount)
+      {
+         auto* const node = tasks.top().second.first;
+         tasks.pop();
+
+         // The root is always the first Node to be split, and its children have been estimated:
+         if (node != &root)
+         {
+            estimateChildren(*node);
+         }
+
+         onSplit(*node);
+
+         SiblingRange<NodeType> run{ nullptr, nullptr };
+         double runSize{ 0 };
+
+         for (const auto& [child, childSize] : children)
+         {
+            if (run.first && runSize + childSize > taskSize)
+            {
+               tasks.emplace(runSize, run);
+               run.first = nullptr;
+               runSize = 0;
+            }
+
+            if (!run.first)
+            {
+               run.first = child;
+            }
+
+            run.last = child;
+            runSize += childSize;
+         }
+
+         if (run.first)
+         {
+            tasks.emplace(runSize, run);
+         }
+      }
+
+      std::vector<SiblingRange<NodeType>> ranges;
+      ranges.reserve(tasks.size());
+
+      for (; !tasks.empty(); tasks.pop())
+      {
+         ranges.emplace_back(tasks.top().second);
+      }
+
+      return ranges;
+   }
+
+   /**
+   * @brief Finds the subtrees that were folded by the tasks of a parallel fold, while the subtrees
+   * that were split up are folded on top of them.
+   *
+   * The lookups have to happen in pre-order. The first Node of each task is found by binary search
+   * over a sorted array; the remaining Nodes of its run are the siblings that a pre-order fold
+   * enters right after it, so those are simply taken in order.
+   */
+   template<
+      typename NodeType,
+      typename ValueType
+   >
+   class FoldedTaskLookup
+   {
+   public:
+
+      FoldedTaskLookup(
+         const std::vector<SiblingRange<NodeType>>& tasks,
+         const std::vector<std::vector<FoldedSubtree<ValueType>>>& folded)
+         :
+         m_folded{ folded },
+         m_offsets(tasks.size()),
+         m_activeTask{ tasks.size() }
+      {
+         m_firstNodes.reserve(tasks.size());
+         for (std::size_t task{ 0 }; task < tasks.size(); ++task)
+         {
+            m_firstNodes.emplace_back(tasks[task].first, task);
+         }
+
+         std::sort(std::begin(m_firstNodes), std::end(m_firstNodes),
+            [] (const auto& lhs, const auto& rhs) noexcept
+         {
+            return std::less<const NodeType*>{ }(lhs.first, rhs.first);
+         });
+      }
+
+      /**
+      * @param[in] node              The Node that the fold is entering.
+      * @param[in] slot              The pre-order position of the Node within the fold.
+      *
+      * @returns The folded subtree rooted at the Node, or a null pointer if no task folded it.
+      */
+      const FoldedSubtree<ValueType>* Find(
+         const NodeType& node,
+         std::size_t slot)
+      {
+         if (m_activeTask < m_folded.size() && m_nextRoot < m_folded[m_activeTask].size())
+         {
+            return &m_folded[m_activeTask][m_nextRoot++];
+         }
+
+         const auto match = std::lower_bound(std::begin(m_firstNodes), std::end(m_firstNodes),
+            &node, [] (const auto& entry, const NodeType* target) noexcept
+         {
+            return std::less<const NodeType*>{ }(entry.first, target);
+         });
+
+         if (match == std::end(m_firstNodes) || match->first != &node)
+         {
+            return nullptr;
+         }
+
+         m_activeTask = match->second;
+         m_offsets[m_activeTask] = slot;
+         m_nextRoot = 1;
+
+         return &m_folded[m_activeTask].front();
+      }
+
+      /**
+      * @returns The pre-order position at which the run of the specified task begins, once its
+      * first Node has been found.
+      */
+      std::size_t GetOffset(std::size_t task) const noexcept
+      {
+         return m_offsets[task];
+      }
+
+   private:
+
+      const std::vector<std::vector<FoldedSubtree<ValueType>>>& m_folded;
+
+      std::vector<std::pair<const NodeType*, std::size_t>> m_firstNodes;
+      std::vector<std::size_t> m_offsets;
+
+      std::size_t m_activeTask;
+      std::size_t m_nextRoot{ 0 };
+   };
+
+   /**
+   * @brief Runs a fixed number of tasks on up to the specified number of threads, including the
+   * calling thread. The tasks are dealt out round-robin, in order, after which idle threads steal
+   * from the others.
+   *
+   * If a task throws, the tasks that haven't been started yet are abandoned, and the first
+   * exception is rethrown once every thread has finished.
+   *
+   * @param[in] taskCount           The number of tasks.
+   * @param[in] threadCount         The maximum number of threads to use.
+   * @param[in] work                A callable type that runs a single task. This type should be
+   *                                equivalent to:
+   *                                   void work(std::size_t task, unsigned int thread);
+   */
+   template<typename WorkType>
+   void RunTasks(
+      std::size_t taskCount,
+      unsigned int threadCount,
+      const WorkType& work)
+   {
+      threadCount = static_cast<unsigned int>(
+         std::min<std::size_t>(std::max(threadCount, 1u), taskCount));
+
+      if (threadCount <= 1)
+      {
+         for (std::size_t task{ 0 }; task < taskCount; ++task)
+         {
+            work(task, 0);
+         }
+
+         return;
+      }
+
+      WorkStealingQueues<std::size_t> queues{ threadCount };
+      for (std::size_t task{ 0 }; task < taskCount; ++task)
+      {
+         queues.Push(task % threadCount, task);
+      }
+
+      std::atomic<bool> hasFailed{ false };
+      std::exception_ptr failure;
+      std::mutex failureMutex;
+
+      const auto runThread = [&] (unsigned int thread)
+      {
+         try
+         {
+            std::size_t task{ 0 };
+            while (!hasFailed.load(std::memory_order_relaxed) && queues.Pop(thread, task))
+            {
+               work(task, thread);
+            }
+         }
+         catch (...)
+         {
+            const std::lock_guard<std::mutex> lock{ failureMutex };
+            if (!failure)
+            {
+               failure = std::current_exception();
+            }
+
+            hasFailed.store(true, std::memory_order_relaxed);
+         }
+      };
+
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount - 1);
+
+      for (unsigned int thread{ 1 }; thread < threadCount; ++thread)
+      {
+         try
+         {
+            threads.emplace_back(runThread, thread);
+         }
+         catch (const std::system_error&)
+         {
+            // The queues of the threads that couldn't be started will simply be stolen from:
+            break;
+         }
+      }
+
+      runThread(0);
+
+      for (auto& thread : threads)
+      {
+         thread.join();
+      }
+
+      if (failure)
+      {
+         std::rethrow_exception(failure);
+      }
+   }
+
+#if defined(__cpp_impl_coroutine)
+   /**
+   * @brief A per-thread cache of coroutine frames, bucketed by size, so that generators that are
+   * created over and over again (one per subtree, say) don't each cost a trip to the heap.
+   *
+   * A frame that is freed on a different thread than the one it was allocated on simply ends up
+   * in the cache of the thread that freed it; all frames in a bucket have the same size.
+   */
+   class FramePool
+   {
+   public:
+
+      static void* Allocate(std::size_t size)
+      {
+         const auto bucket = BucketOf(size);
+         if (bucket >= BUCKET_COUNT)
+         {
+            return ::operator new(size);
+         }
+
+         auto& cache = Cache();
+         if (auto* const frame = cache.heads[bucket])
+         {
+            cache.heads[bucket] = frame->next;
+            --cache.counts[bucket];
+
+            return frame;
+         }
+
+         return ::operator new((bucket + 1) * GRANULARITY);
+      }
+
+      static void Deallocate(
+         void* frame,
+         std::size_t size) noexcept
+      {
+         const auto bucket = BucketOf(size);
+         if (bucket >= BUCKET_COUNT)
+         {
+            ::operator delete(frame);
+            return;
+         }
+
+         auto& cache = Cache();
+         if (cache.counts[bucket] >= MAX_CACHED_FRAMES)
+         {
+            ::operator delete(frame);
+            return;
+         }
+
+         cache.heads[bucket] = ::new (frame) FreeFrame{ cache.heads[bucket] };
+         ++cache.counts[bucket];
+      }
+
+   private:
+
+      static constexpr std::size_t GRANULARITY{ 64 };
+      static constexpr std::size_t BUCKET_COUNT{ 16 };
+      static constexpr std::size_t MAX_CACHED_FRAMES{ 64 };
+
+      struct FreeFrame
+      {
+         FreeFrame* next;
+      };
+
+      struct ThreadCache
+      {
+         ~ThreadCache()
+         {
+            for (auto* frame : heads)
+            {
+               while (frame)
+               {
+                  auto* const next = frame->next;
+                  ::operator delete(frame);
+                  frame = next;
+               }
+            }
+         }
+
+         std::array<FreeFrame*, BUCKET_COUNT> heads{ };
+         std::array<std::size_t, BUCKET_COUNT> counts{ };
+      };
+
+      static std::size_t BucketOf(std::size_t size) noexcept
+      {
+         return (size - 1) / GRANULARITY;
+      }
+
+      static ThreadCache& Cache()
+      {
+         thread_local ThreadCache cache;
+         return cache;
+      }
+   };
+
+   /**
+   * @brief A lazily evaluated sequence whose elements are produced by a coroutine, one co_yield at
+   * a time. The coroutine doesn't start running until the first element is requested.
+   *
+   * Yielded values aren't copied; the Generator refers to them for as long as the coroutine is
+   * suspended, which is also as long as they remain valid.
+   */
+   template<typename ReferenceType>
+   class Generator
+   {
+   public:
+
+      using ValueType = std::remove_cv_t<std::remove_reference_t<ReferenceType>>;
+
+      class promise_type
+      {
+      public:
+
+         Generator get_return_object() noexcept
+         {
+            return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+         }
+
+         std::suspend_always initial_suspend() const noexcept
+         {
+            return { };
+         }
+
+         std::suspend_always final_suspend() const noexcept
+         {
+            return { };
+         }
+
+         std::suspend_always yield_value(std::remove_reference_t<ReferenceType>& value) noexcept
+         {
+            m_current = std::addressof(value);
+            return { };
+         }
+
+         std::suspend_always yield_value(std::remove_reference_t<ReferenceType>&& value) noexcept
+         {
+            // The temporary lives until the end of the full expression holding the co_yield,
+            // which is only reached once the coroutine is resumed:
+            m_current = std::addressof(value);
+            return { };
+         }
+
+         // Generators only ever suspend to yield:
+         template<typename AwaitableType>
+         void await_transform(AwaitableType&&) = delete;
+
+         void return_void() const noexcept
+         {
+         }
+
+         void unhandled_exception() const
+         {
+            throw;
+         }
+
+         ReferenceType Current() const noexcept
+         {
+            return static_cast<ReferenceType>(*m_current);
+         }
+
+         static void* operator new(std::size_t size)
+         {
+            return FramePool::Allocate(size);
+         }
+
+         static void operator delete(
+            void* frame,
+            std::size_t size) noexcept
+         {
+            FramePool::Deallocate(frame, size);
+         }
+
+      private:
+
+         std::add_pointer_t<std::remove_reference_t<ReferenceType>> m_current{ nullptr };
+      };
+
+      class Iterator
+      {
+      public:
+
+         using value_type = ValueType;
+         using reference = ReferenceType;
+         using difference_type = std::ptrdiff_t;
+         using iterator_category = std::input_iterator_tag;
+
+         Iterator() noexcept = default;
+
+         explicit Iterator(std::coroutine_handle<promise_type> coroutine) noexcept :
+            m_coroutine{ coroutine }
+         {
+         }
+
+         reference operator*() const noexcept
+         {
+            return m_coroutine.promise().Current();
+         }
+
+         Iterator& operator++()
+         {
+            m_coroutine.resume();
+            return *this;
+         }
+
+         void operator++(int)
+         {
+            ++*this;
+         }
+
+         friend bool operator==(const Iterator& itr, std::default_sentinel_t) noexcept
+         {
+            return !itr.m_coroutine || itr.m_coroutine.done();
+         }
+
+      private:
+
+         std::coroutine_handle<promise_type> m_coroutine;
+      };
+
+      Generator(Generator&& other) noexcept :
+         m_coroutine{ std::exchange(other.m_coroutine, nullptr) }
+      {
+      }
+
+      Generator& operator=(Generator other) noexcept
+      {
+         std::swap(m_coroutine, other.m_coroutine);
+         return *this;
+      }
+
+      ~Generator()
+      {
+         if (m_coroutine)
+         {
+            m_coroutine.destroy();
+         }
+      }
+
+      /**
+      * @returns An iterator to the first element, which runs the coroutine up to its first
+      * co_yield. Since a Generator can only be traversed once, this should only be called once.
+      */
+      Iterator begin()
+      {
+         m_coroutine.resume();
+         return Iterator{ m_coroutine };
+      }
+
+      std::default_sentinel_t end() const noexcept
+      {
+         return std::default_sentinel;
+      }
+
+   private:
+
+      explicit Generator(std::coroutine_handle<promise_type> coroutine) noexcept :
+         m_coroutine{ coroutine }
+      {
+      }
+
+      std::coroutine_handle<promise_type> m_coroutine;
+   };
+#endif
+
+#if defined(__cpp_lib_ranges)
+   /**
+   * @brief A view over one of the traversals of a Tree, from the Node that an iterator starts at
+   * up to the Tree::Sentinel that ends every traversal.
+   *
+   * The view holds nothing but the starting iterator, so it is cheap to copy, and its iterators
+   * stay valid after the view itself is gone.
+   */
+   template<
+      typename IteratorType,
+      typename SentinelType
+   >
+   class TraversalView
+      : public std::ranges::view_interface<TraversalView<IteratorType, SentinelType>>
+   {
+   public:
+
+      TraversalView() noexcept = default;
+
+      explicit TraversalView(IteratorType first) noexcept(
+         std::is_nothrow_move_constructible_v<IteratorType>)
+         :
+         m_first{ std::move(first) }
+      {
+      }
+
+      IteratorType begin() const
+      {
+         return m_first;
+      }
+
+      SentinelType end() const noexcept
+      {
+         return { };
+      }
+
+   private:
+
+      IteratorType m_first;
+   };
+#endif
+}
+
+#if defined(__cpp_lib_ranges)
+template<
+   typename IteratorType,
+   typename SentinelType
+>
+inline constexpr bool std::ranges::enable_borrowed_range<
+   TreeInternals::TraversalView<IteratorType, SentinelType>> = true;
+#endif
+
+/**
+* @brief The order in which Tree::Traverse visits the nodes of a subtree.
+*/
+enum class TraversalOrder
+{
+   PRE_ORDER,
+   POST_ORDER
+};
+
+/**
+* @brief What Tree::Traverse should do after the visitor has seen a Node.
+*/
+enum class VisitResult
+{
+   CONTINUE,
+   SKIP_CHILDREN,
+   STOP
+};
+
+/**
+* @brief Controls how Tree::ParallelForEach divides a Tree among threads.
+*/
+struct ParallelOptions
+{
+   /**
+   * The number of threads to visit the Nodes with, including the calling thread; zero means one
+   * per hardware thread.
+   */
+   unsigned int threadCount{ 0 };
+
+   /**
+   * Subtrees that are estimated to hold no more Nodes than this are never split up any further,
+   * and a subtree of this size or smaller is visited by the calling thread alone.
+   */
+   std::size_t grainSize{ 4096 };
+
+   /**
+   * The number of tasks to divide the Tree into, per thread. More tasks make up for imprecise
+   * size estimates, at the cost of more work up front.
+   */
+   unsigned int tasksPerThread{ 8 };
+};
+
+/**
+* The Tree class declares a basic tree, built on top of templatized Node nodes.
+*
+* Each tree consists of a simple root Node and nothing else.
+*
+* Optionally, every Node can maintain an aggregate of the data in its subtree, as described by an
+* aggregate policy. Such a policy should look like:
+*
+*    struct SizeAggregate
+*    {
+*       using ValueType = std::uintmax_t;
+*
+*       static ValueType Lift(const DataType& data);
+*       static ValueType Combine(const ValueType& lhs, const ValueType& rhs);
+*
+*       // Optional; allows removals to be propagated without rescanning any siblings:
+*       static ValueType Subtract(const ValueType& total, const ValueType& part);
+*    };
+*
+* Combine has to be associative and commutative, and none of the functions should throw. The
+* aggregate of a Node is the combination of its own lifted data with the aggregates of all of its
+* children, and is kept up to date as nodes are added, removed, spliced, or have their data
+* replaced through Node::SetData.
+*
+* Optionally, all leaves can additionally be threaded onto a doubly-linked list, in the order in
+* which a LeafIterator visits them. The list is kept up to date as nodes are added, removed,
+* spliced, or sorted, at the cost of two more pointers per Node, and makes leaf iteration a matter
+* of following a single pointer per leaf, without touching any of the interior nodes.
+*/
+template<
+   typename DataType,
+   typename AggregatePolicy = TreeInternals::NoAggregate,
+   bool ThreadedLeaves = false
+>
+class Tree
+{
+public:
+
+   static constexpr bool HAS_AGGREGATE =
+      !std::is_same_v<AggregatePolicy, TreeInternals::NoAggregate>;
+
+   static constexpr bool THREADED_LEAVES = ThreadedLeaves;
+
+   class Node;
+
+   class Iterator;
+   class PreOrderIterator;
+   class PostOrderIterator;
+   class LeafIterator;
+   class LevelOrderIterator;
+   class SiblingIterator;
+
+   template<typename IteratorType>
+   class PrefetchingIterator;
+
+   /**
+   * The number of Nodes that a PrefetchingIterator keeps prefetched ahead of the Node being
+   * visited, unless specified otherwise.
+   */
+   static constexpr std::size_t DEFAULT_PREFETCH_DISTANCE{ 4 };
+
+   /**
+   * The largest prefetch distance that a PrefetchingIterator supports; larger distances are
+   * clamped to this one.
+   */
+   static constexpr std::size_t MAX_PREFETCH_DISTANCE{ 32 };
+
+   /**
+   * @brief Marks the end of any traversal, without needing to know where that traversal started.
+   *
+   * Every iterator compares equal to the Sentinel once it has run past its last Node, which makes
+   * the Sentinel a cheaper end marker than an end iterator when the algorithm accepts one.
+   */
+   struct Sentinel
+   {
+   };
+
+   // Typedefs needed for STL compliance:
+   using value_type = Node;
+   using reference = Node&;
+   using const_reference = const Node&;
+
+   /**
+   * @brief Default constructor.
+   */
+   Tree() :
+      m_root{ new Node{ } }
+   {
+   }
+
+   /**
+   * @brief Tree constructs a new Tree with the provided data encapsulated in a new
+   * Node.
+   */
+   Tree(DataType data) :
+      m_root{ new Node{ data } }
+   {
+   }
+
+   /**
+   * @brief Copy constructor.
+   */
+   Tree(const Tree& other) :
+      m_root{ new Node{ *other.m_root } }
+   {
+   }
+
+   /**
+   * @brief Assignment operator.
+   */
+   Tree& operator=(Tree other)
+   {
+      swap(*this, other);
+      return *this;
+   }
+
+   /**
+   * @brief Swaps all member variables of the left-hand side with that of the right-hand side.
+   */
+   friend void swap(
+      Tree& lhs,
+      Tree& rhs) noexcept(noexcept(swap(lhs.m_root, rhs.m_root)))
+   {
+      // Enable Argument Dependent Lookup (ADL):
+      using std::swap;
+
+      swap(lhs.m_root, rhs.m_root);
+   }
+
+   /**
+   * @brief Deletes the root Node, which, in turn, will trigger a deletion of every
+   * Node in the Tree.
+   */
+   ~Tree()
+   {
+      delete m_root;
+   }
+
+   /**
+   * @returns A pointer to the root Node.
+   */
+   inline Node* GetRoot() const noexcept
+   {
+      return m_root;
+   }
+
+   /**
+   * @brief Computes the number of nodes in the Tree.
+   *
+   * @complexity Linear in the size of the Tree.
+   *
+   * @returns The total number of nodes in the Tree. This includes leaf and non-leaf nodes,
+   * in addition to the root node.
+   */
+   inline auto Size() const noexcept
+   {
+      return std::count_if(std::begin(*this), std::end(*this),
+         [] (const auto&) noexcept
+      {
+         return true;
+      });
+   }
+
+   /**
+   * @brief Sorts the children of every Node in the Tree, with the sibling lists being sorted
+   * concurrently. Sibling lists that are large enough to warrant it are, in turn, sorted by
+   * several workers at once.
+   *
+   * Since every sibling list is stably sorted, the result is identical to that of calling
+   * Node::SortChildren on every Node in turn.
+   *
+   * @param[in] comparator          A callable type to be used as the basis for the sorting
+   *                                comparison; see Node::SortChildren. The comparator may be
+   *                                invoked from several threads at once.
+   * @param[in] policy              The execution policy that governs the parallelism.
+   */
+   template<
+      typename ComparatorType,
+      typename ExecutionPolicyType
+   >
+   void SortAll(
+      const ComparatorType& comparator,
+      ExecutionPolicyType&& policy)
+   {
+      // Sibling lists at least this long are split across workers, instead of being sorted by a
+      // single worker:
+      constexpr auto LARGE_SIBLING_LIST{ 4096u };
+
+      std::vector<Node*> smallLists;
+      std::vector<Node*> largeLists;
+
+      std::for_each(beginPreOrder(), endPreOrder(), [&] (Node& node)
+      {
+         if (node.GetChildCount() >= LARGE_SIBLING_LIST)
+         {
+            largeLists.emplace_back(&node);
+         }
+         else if (node.GetChildCount() > 1)
+         {
+            smallLists.emplace_back(&node);
+         }
+      });
+
+      // Sibling lists are sorted concurrently, so the threaded leaf list, if any, can't be
+      // patched up as each one is sorted; it's rebuilt in a single pass at the end instead:
+      std::for_each(policy, std::begin(smallLists), std::end(smallLists),
+         [&] (Node* node) { node->SortChildList(std::execution::seq, comparator); });
+
+      for (auto* node : largeLists)
+      {
+         node->SortChildList(policy, comparator);
+      }
+
+      if constexpr (THREADED_LEAVES)
+      {
+         if (m_root)
+         {
+            m_root->ThreadSubtreeLeaves();
+         }
+      }
+   }
+
+   /**
+   * @brief Deletes the Node that the iterator points to, along with its entire subtree.
+   *
+   * @param[in] itr                 An iterator pointing to the Node to be deleted.
+   *
+   * @returns An iterator pointing to the Node that follows the deleted subtree, in pre-order.
+   */
+   PreOrderIterator Erase(PreOrderIterator itr) noexcept
+   {
+      assert(itr);
+
+      auto& node = *itr;
+      itr.SkipDescendants();
+
+      Delete(node);
+
+      return itr;
+   }
+
+   /**
+   * @brief Deletes the Node that the iterator points to, along with its entire subtree; since
+   * the iteration is in post-order, the subtree will have already been visited.
+   *
+   * @param[in] itr                 An iterator pointing to the Node to be deleted.
+   *
+   * @returns An iterator pointing to the Node that follows the deleted Node, in post-order.
+   */
+   PostOrderIterator Erase(PostOrderIterator itr) noexcept
+   {
+      assert(itr);
+
+      auto& node = *itr;
+      ++itr;
+
+      Delete(node);
+
+      return itr;
+   }
+
+   /**
+   * @brief Removes every Node that satisfies the predicate, along with its entire subtree, in a
+   * single traversal of the Tree. The root itself is never removed.
+   *
+   * @see Node::RemoveDescendantsIf
+   *
+   * @returns The total number of nodes removed.
+   */
+   template<typename PredicateType>
+   std::size_t RemoveIf(const PredicateType& predicate)
+   {
+      return m_root ? m_root->RemoveDescendantsIf(predicate) : 0;
+   }
+
+   /**
+   * @brief Removes every Node that satisfies the predicate, along with its entire subtree, with
+   * independent subtrees being pruned in parallel. The root itself is never removed.
+   *
+   * @see Node::RemoveDescendantsIf
+   *
+   * @returns The total number of nodes removed.
+   */
+   template<
+      typename PredicateType,
+      typename ExecutionPolicyType
+   >
+   std::size_t RemoveIf(
+      const PredicateType& predicate,
+      ExecutionPolicyType&& policy)
+   {
+      return m_root ? m_root->RemoveDescendantsIf(predicate, policy) : 0;
+   }
+
+   /**
+   * @brief Visits every Node in the subtree rooted at the specified Node exactly once, with the
+   * work being spread across several threads.
+   *
+   * The subtree is first divided into tasks: starting from the root, the subtree with the largest
+   * estimated size is split into the subtrees of its children, until every task is small enough.
+   * Runs of small sibling subtrees are grouped into a single task, and the number of tasks stays
+   * close to the requested number per thread. The roots of the split subtrees are visited by the
+   * calling thread along the way. The tasks are
+   * then dealt out, largest first, to per-thread queues, from which idle threads steal. Within a
+   * task, the Nodes are visited in pre-order; there is no ordering between tasks.
+   *
+   * If the visitor throws, the remaining tasks are abandoned, and the first exception is rethrown
+   * once every thread has finished.
+   *
+   * @param[in] root                The root of the subtree to visit; may be const.
+   * @param[in] visitor             A callable type that is invoked on every Node, from several
+   *                                threads at once. It may modify the data of the Node it is given,
+   *                                but not the structure of the Tree. This type should be
+   *                                equivalent to either of:
+   *                                   void visitor(Node& node);
+   *                                   void visitor(Node& node, unsigned int thread);
+   *                                The latter is passed the index of the calling thread, which is
+   *                                zero for the thread that called ParallelForEach, so that
+   *                                results can be accumulated per thread without synchronization.
+   * @param[in] options             How the work is divided.
+   */
+   template<
+      typename NodeType,
+      typename VisitorType
+   >
+   static void ParallelForEach(
+      NodeType& root,
+      VisitorType&& visitor,
+      const ParallelOptions& options = { })
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      const auto visit = [&] (NodeType& node, unsigned int thread)
+      {
+         if constexpr (std::is_invocable_v<VisitorType&, NodeType&, unsigned int>)
+         {
+            visitor(node, thread);
+         }
+         else
+         {
+            visitor(node);
+         }
+      };
+
+      const auto visitSubtree = [&] (NodeType& subtree, unsigned int thread)
+      {
+         Traverse<TraversalOrder::PRE_ORDER>(subtree, [&] (NodeType& node)
+         {
+            visit(node, thread);
+            return VisitResult::CONTINUE;
+         });
+      };
+
+      const auto threadCount = options.threadCount
+         ? options.threadCount
+         : std::max(std::thread::hardware_concurrency(), 1u);
+
+      if (threadCount == 1)
+      {
+         visitSubtree(root, 0);
+         return;
+      }
+
+      const auto tasks = TreeInternals::DivideIntoTasks(root,
+         std::size_t{ threadCount } * std::max(options.tasksPerThread, 1u), options.grainSize,
+         [&] (NodeType& node) { visit(node, 0); });
+
+      TreeInternals::RunTasks(tasks.size(), threadCount, [&] (std::size_t task, unsigned int thread)
+      {
+         tasks[task].ForEach([&] (NodeType& subtree) { visitSubtree(subtree, thread); });
+      });
+   }
+
+   /**
+   * @brief Computes a value for every Node in the subtree rooted at the specified Node from the
+   * values of its children, with disjoint subtrees being folded concurrently.
+   *
+   * The value of a Node starts out as its leaf value, into which the values of its children are
+   * then combined, from first to last:
+   *    combine(...combine(leafValue(node), value(firstChild))..., value(lastChild))
+   *
+   * The subtree is divided up as in ParallelForEach. Every thread folds entire subtrees, after
+   * which the calling thread joins their values at their parents. Both callables are invoked from
+   * several threads at once.
+   *
+   * @param[in] root                The root of the subtree to fold; may be const.
+   * @param[in] leafValue           A callable type that computes what a Node contributes on its
+   *                                own, which is also the value of a leaf. This type should be
+   *                                equivalent to:
+   *                                   ValueType leafValue(const Node& node);
+   * @param[in] combine             A callable type that combines the value of a child into the
+   *                                value of its parent. This type should be equivalent to:
+   *                                   ValueType combine(ValueType value, const ValueType& child);
+   * @param[in] options             How the work is divided.
+   *
+   * @returns The values of all Nodes in the subtree, in pre-order. The first value is that of the
+   * root, and the values line up with a pre-order traversal of the subtree.
+   */
+   template<
+      typename NodeType,
+      typename LeafValueType,
+      typename CombineType
+   >
+   static auto ParallelFoldUp(
+      NodeType& root,
+      const LeafValueType& leafValue,
+      const CombineType& combine,
+      const ParallelOptions& options = { })
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the fold has to be a Node of this Tree.");
+
+      using ValueType = std::decay_t<decltype(leafValue(std::as_const(root)))>;
+      using FoldedType = TreeInternals::FoldedSubtree<ValueType>;
+
+      static_assert(std::is_default_constructible_v<ValueType>,
+         "The values of a fold have to be default constructible to be collected.");
+
+      const auto threadCount = options.threadCount
+         ? options.threadCount
+         : std::max(std::thread::hardware_concurrency(), 1u);
+
+      const auto tasks = threadCount == 1
+         ? std::vector<TreeInternals::SiblingRange<NodeType>>{ { &root, &root } }
+         : TreeInternals::DivideIntoTasks(root,
+            std::size_t{ threadCount } * std::max(options.tasksPerThread, 1u), options.grainSize,
+            [] (NodeType&) noexcept { });
+
+      const auto noneFolded = [] (const NodeType&, std::size_t) noexcept -> const FoldedType*
+      {
+         return nullptr;
+      };
+
+      // Since a run of siblings covers a contiguous stretch of the pre-order traversal, each task
+      // collects the values of its run in a single array, which is moved into place at the end:
+      std::vector<std::vector<FoldedType>> folded(tasks.size());
+      std::vector<std::vector<ValueType>> taskValues(tasks.size());
+
+      TreeInternals::RunTasks(tasks.size(), threadCount, [&] (std::size_t task, unsigned int)
+      {
+         auto& values = taskValues[task];
+         std::size_t offset{ 0 };
+
+         const auto storeValue = [&] (NodeType&, std::size_t slot, const ValueType& value)
+         {
+            if (offset + slot >= values.size())
+            {
+               values.resize(offset + slot + 1);
+            }
+
+            values[offset + slot] = value;
+         };
+
+         tasks[task].ForEach([&] (NodeType& subtree)
+         {
+            folded[task].emplace_back(
+               FoldSubtree(subtree, leafValue, combine, noneFolded, storeValue));
+
+            offset += folded[task].back().size;
+         });
+      });
+
+      // Join the folded subtrees at their parents, while working out where each task's values
+      // have to go:
+      TreeInternals::FoldedTaskLookup<NodeType, ValueType> lookup{ tasks, folded };
+
+      const auto findFolded = [&] (const NodeType& node, std::size_t slot)
+      {
+         return lookup.Find(node, slot);
+      };
+
+      std::vector<ValueType> values;
+
+      const auto storeValue = [&] (NodeType&, std::size_t slot, const ValueType& value)
+      {
+         if (slot >= values.size())
+         {
+            values.resize(slot + 1);
+         }
+
+         values[slot] = value;
+      };
+
+      values.resize(FoldSubtree(root, leafValue, combine, findFolded, storeValue).size);
+
+      std::vector<std::size_t> indices(tasks.size());
+      std::iota(std::begin(indices), std::end(indices), std::size_t{ 0 });
+
+      std::for_each(std::execution::par, std::begin(indices), std::end(indices),
+         [&] (std::size_t task)
+      {
+         auto& source = taskValues[task];
+         std::move(std::begin(source), std::end(source), std::next(
+            std::begin(values), static_cast<std::ptrdiff_t>(lookup.GetOffset(task))));
+      });
+
+      return values;
+   }
+
+   /**
+   * @brief Computes a value for every Node in the subtree rooted at the specified Node from the
+   * values of its children, with disjoint subtrees being folded concurrently, and hands each
+   * value to the store callable instead of collecting them.
+   *
+   * @see ParallelFoldUp, which describes how the values are computed.
+   *
+   * @param[in] store               A callable type that receives the value of each Node, from
+   *                                several threads at once; the values of the children of a Node
+   *                                are always stored before its own. This type should be
+   *                                equivalent to:
+   *                                   void store(Node& node, const ValueType& value);
+   *
+   * @returns The value of the root.
+   */
+   template<
+      typename NodeType,
+      typename LeafValueType,
+      typename CombineType,
+      typename StoreType
+   >
+   static auto ParallelFoldUpInto(
+      NodeType& root,
+      const LeafValueType& leafValue,
+      const CombineType& combine,
+      const StoreType& store,
+      const ParallelOptions& options = { })
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the fold has to be a Node of this Tree.");
+
+      using ValueType = std::decay_t<decltype(leafValue(std::as_const(root)))>;
+      using FoldedType = TreeInternals::FoldedSubtree<ValueType>;
+
+      const auto threadCount = options.threadCount
+         ? options.threadCount
+         : std::max(std::thread::hardware_concurrency(), 1u);
+
+      const auto tasks = threadCount == 1
+         ? std::vector<TreeInternals::SiblingRange<NodeType>>{ { &root, &root } }
+         : TreeInternals::DivideIntoTasks(root,
+            std::size_t{ threadCount } * std::max(options.tasksPerThread, 1u), options.grainSize,
+            [] (NodeType&) noexcept { });
+
+      const auto noneFolded = [] (const NodeType&, std::size_t) noexcept -> const FoldedType*
+      {
+         return nullptr;
+      };
+
+      const auto storeValue = [&] (NodeType& node, std::size_t, const ValueType& value)
+      {
+         store(node, value);
+      };
+
+      std::vector<std::vector<FoldedType>> folded(tasks.size());
+
+      TreeInternals::RunTasks(tasks.size(), threadCount, [&] (std::size_t task, unsigned int)
+      {
+         tasks[task].ForEach([&] (NodeType& subtree)
+         {
+            folded[task].emplace_back(
+               FoldSubtree(subtree, leafValue, combine, noneFolded, storeValue));
+         });
+      });
+
+      // Join the folded subtrees at their parents; their roots have already been stored:
+      TreeInternals::FoldedTaskLookup<NodeType, ValueType> lookup{ tasks, folded };
+
+      const auto findFolded = [&] (const NodeType& node, std::size_t slot)
+      {
+         return lookup.Find(node, slot);
+      };
+
+      return FoldSubtree(root, leafValue, combine, findFolded, storeValue).value;
+   }
+
+   /**
+   * @brief Finds the descendants of the specified Node with the largest keys, without sorting
+   * (or even collecting) all of them.
+   *
+   * The subtree is divided into tasks as in ParallelForEach, which a number of threads work
+   * through, each retaining its best candidates in a bounded heap. The heaps are merged once all
+   * threads are done, so that memory use stays at O(k) per thread.
+   *
+   * @param[in] subtreeRoot         The Node whose descendants are to be considered. The Node
+   *                                itself is not considered.
+   * @param[in] k                   The maximum number of nodes to return.
+   * @param[in] keyExtractor        A callable type that computes the key of a node. This type
+   *                                should be equivalent to:
+   *                                   KeyType keyExtractor(const Node& node);
+   * @param[in] predicate           A callable type that decides whether a node is a candidate at
+   *                                all. This type should be equivalent to:
+   *                                   bool predicate(const Node& node);
+   * @param[in] policy              With std::execution::seq, the search stays on the calling
+   *                                thread; otherwise, it's spread across all cores.
+   *
+   * @returns The (at most) k candidate nodes with the largest keys, ordered from the largest key
+   * to the smallest.
+   */
+   template<
+      typename KeyExtractorType,
+      typename PredicateType,
+      typename ExecutionPolicyType
+   >
+   static std::vector<Node*> TopK(
+      const Node& subtreeRoot,
+      std::size_t k,
+      const KeyExtractorType& keyExtractor,
+      const PredicateType& predicate,
+      [[maybe_unused]] ExecutionPolicyType&& policy)
+   {
+      using KeyType = std::decay_t<decltype(keyExtractor(std::declval<const Node&>()))>;
+      using HeapType = TreeInternals::BoundedHeap<KeyType, Node*>;
+
+      if (k == 0 || !subtreeRoot.HasChildren())
+      {
+         return { };
+      }
+
+      constexpr auto isSequential = std::is_same_v<
+         std::decay_t<ExecutionPolicyType>, std::execution::sequenced_policy>;
+
+      const auto threadCount = isSequential
+         ? 1u
+         : std::max(std::thread::hardware_concurrency(), 1u);
+
+      const ParallelOptions options{ threadCount };
+
+      std::vector<HeapType> heaps(threadCount, HeapType{ k });
+
+      const auto offer = [&] (const Node& node, unsigned int thread)
+      {
+         if (&node != &subtreeRoot && predicate(node))
+         {
+            // The candidates are handed back as mutable Nodes, just as the iterators would:
+            heaps[thread].Offer(keyExtractor(node), const_cast<Node*>(&node));
+         }
+      };
+
+      // The subtree is divided up as in ParallelForEach, with each thread retaining its best
+      // candidates in a heap of its own:
+      const auto tasks = TreeInternals::DivideIntoTasks(subtreeRoot,
+         threadCount == 1 ? 1 : std::size_t{ threadCount } * options.tasksPerThread,
+         options.grainSize,
+         [&] (const Node& node) { offer(node, 0); });
+
+      TreeInternals::RunTasks(tasks.size(), threadCount, [&] (std::size_t task, unsigned int thread)
+      {
+         tasks[task].ForEach([&] (const Node& subtree)
+         {
+            Traverse<TraversalOrder::PRE_ORDER>(subtree, [&] (const Node& node)
+            {
+               offer(node, thread);
+               return VisitResult::CONTINUE;
+            });
+         });
+      });
+
+      for (auto thread = 1u; thread < heaps.size(); ++thread)
+      {
+         heaps.front().Merge(std::move(heaps[thread]));
+      }
+
+      const auto entries = heaps.front().Extract();
+
+      std::vector<Node*> result;
+      result.reserve(entries.size());
+
+      std::transform(std::begin(entries), std::end(entries), std::back_inserter(result),
+         [] (const auto& entry) noexcept { return entry.second; });
+
+      return result;
+   }
+
+   /**
+   * @brief Finds the descendants of the specified Node with the largest keys, with the search
+   * being spread across all available cores.
+   *
+   * @see The overload above, which also takes an execution policy.
+   */
+   template<
+      typename KeyExtractorType,
+      typename PredicateType
+   >
+   static std::vector<Node*> TopK(
+      const Node& subtreeRoot,
+      std::size_t k,
+      const KeyExtractorType& keyExtractor,
+      const PredicateType& predicate)
+   {
+      return TopK(subtreeRoot, k, keyExtractor, predicate, std::execution::par);
+   }
+
+   /**
+   * @returns The zero-indexed depth of the Node in its Tree.
+   */
+   static unsigned int Depth(const Node& node) noexcept
+   {
+      unsigned int depth = 0;
+
+      const Node* nodePtr = &node;
+      while (nodePtr->GetParent())
+      {
+         ++depth;
+         nodePtr = nodePtr->GetParent();
+      }
+
+      return depth;
+   }
+
+   /**
+   * @brief Visits every Node in the subtree rooted at the specified Node, in a single loop that
+   * doesn't go through any iterator.
+   *
+   * In pre-order, a visitor that returns VisitResult::SKIP_CHILDREN causes the descendants of the
+   * visited Node to be skipped without being touched at all. In post-order, the descendants of a
+   * Node have already been visited by the time the Node itself is, so SKIP_CHILDREN is treated the
+   * same as VisitResult::CONTINUE. Either way, VisitResult::STOP ends the traversal immediately.
+   *
+   * The visitor may modify the data of the Nodes it visits, but not the structure of the Tree.
+   *
+   * @tparam Order                  The order in which to visit the Nodes.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const.
+   * @param[in] visitor             A callable type that is invoked on every visited Node. This
+   *                                type should be equivalent to:
+   *                                   VisitResult visitor(Node& node);
+   *
+   * @returns False if the visitor stopped the traversal, and true otherwise.
+   */
+   template<
+      TraversalOrder Order,
+      typename NodeType,
+      typename VisitorType
+   >
+   static bool Traverse(
+      NodeType& root,
+      VisitorType&& visitor)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      NodeType* node = &root;
+
+      if constexpr (Order == TraversalOrder::PRE_ORDER)
+      {
+         while (true)
+         {
+            const VisitResult result = visitor(*node);
+            if (result == VisitResult::STOP)
+            {
+               return false;
+            }
+
+            if (result == VisitResult::CONTINUE && node->GetFirstChild())
+            {
+               node = node->GetFirstChild();
+               continue;
+            }
+
+            while (node != &root && !node->GetNextSibling())
+            {
+               node = node->GetParent();
+            }
+
+            if (node == &root)
+            {
+               return true;
+            }
+
+            node = node->GetNextSibling();
+         }
+      }
+      else
+      {
+         while (node->GetFirstChild())
+         {
+            node = node->GetFirstChild();
+         }
+
+         while (true)
+         {
+            if (visitor(*node) == VisitResult::STOP)
+            {
+               return false;
+            }
+
+            if (node == &root)
+            {
+               return true;
+            }
+
+            if (node->GetNextSibling())
+            {
+               node = node->GetNextSibling();
+               while (node->GetFirstChild())
+               {
+                  node = node->GetFirstChild();
+               }
+            }
+            else
+            {
+               node = node->GetParent();
+            }
+         }
+      }
+   }
+
+   /**
+   * @brief Walks the subtree rooted at the specified Node depth-first, notifying the visitor both
+   * when a Node is entered (in pre-order) and when it is exited (in post-order), along with the
+   * depth of that Node.
+   *
+   * The depth is tracked as the walk moves up and down the Tree, so that it never needs to be
+   * recomputed by climbing to the root; it is relative to the root of the walk, which has a depth
+   * of zero.
+   *
+   * If OnEnter returns VisitResult::SKIP_CHILDREN, the descendants of the entered Node are skipped,
+   * but the Node itself is still exited. If it returns VisitResult::STOP, the walk ends right
+   * away, without exiting any of the Nodes that are still open. OnEnter may also return void, which
+   * is treated the same as VisitResult::CONTINUE.
+   *
+   * The visitor may modify the data of the Nodes it visits, but not the structure of the Tree.
+   *
+   * @param[in] root                The root of the subtree to walk; may be const.
+   * @param[in] visitor             An object whose member functions should be equivalent to:
+   *                                   VisitResult OnEnter(Node& node, unsigned int depth);
+   *                                   void OnExit(Node& node, unsigned int depth);
+   *
+   * @returns False if the visitor stopped the walk, and true otherwise.
+   */
+   template<
+      typename NodeType,
+      typename VisitorType
+   >
+   static bool Walk(
+      NodeType& root,
+      VisitorType&& visitor)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the walk has to be a Node of this Tree.");
+
+      const auto enter = [&] (NodeType& node, unsigned int depth)
+      {
+         if constexpr (std::is_void_v<decltype(visitor.OnEnter(node, depth))>)
+         {
+            visitor.OnEnter(node, depth);
+            return VisitResult::CONTINUE;
+         }
+         else
+         {
+            return static_cast<VisitResult>(visitor.OnEnter(node, depth));
+         }
+      };
+
+      NodeType* node = &root;
+      unsigned int depth{ 0 };
+
+      while (true)
+      {
+         const VisitResult result = enter(*node, depth);
+         if (result == VisitResult::STOP)
+         {
+            return false;
+         }
+
+         if (result == VisitResult::CONTINUE && node->GetFirstChild())
+         {
+            node = node->GetFirstChild();
+            ++depth;
+
+            continue;
+         }
+
+         // Exit the current Node, along with every ancestor whose last child has just been
+         // exited, until a Node with a next sibling is found:
+         while (true)
+         {
+            visitor.OnExit(*node, depth);
+
+            if (node == &root)
+            {
+               return true;
+            }
+
+            if (node->GetNextSibling())
+            {
+               node = node->GetNextSibling();
+               break;
+            }
+
+            node = node->GetParent();
+            --depth;
+         }
+      }
+   }
+
+#if defined(__cpp_lib_ranges)
+   using PreOrderView = TreeInternals::TraversalView<PreOrderIterator, Sentinel>;
+   using PostOrderView = TreeInternals::TraversalView<PostOrderIterator, Sentinel>;
+   using LeafView = TreeInternals::TraversalView<LeafIterator, Sentinel>;
+   using LevelOrderView = TreeInternals::TraversalView<LevelOrderIterator, Sentinel>;
+
+   /**
+   * @returns A view over all Nodes in the Tree, in pre-order, that can be composed with the
+   * standard range adaptors, as well as with the tree-aware ones in TreeViews.hpp.
+   */
+   PreOrderView PreOrder() const noexcept
+   {
+      return PreOrderView{ beginPreOrder() };
+   }
+
+   /**
+   * @returns A view over all Nodes in the Tree, in post-order.
+   */
+   PostOrderView PostOrder() const noexcept
+   {
+      return PostOrderView{ begin() };
+   }
+
+   /**
+   * @returns A view over all leaves in the Tree, from left to right.
+   */
+   LeafView Leaves() const noexcept
+   {
+      return LeafView{ beginLeaf() };
+   }
+
+   /**
+   * @returns A view over the Nodes in the Tree, in level-order, down to the specified depth.
+   */
+   LevelOrderView LevelOrder(
+      unsigned int maxDepth = std::numeric_limits<unsigned int>::max()) const
+   {
+      return LevelOrderView{ beginLevelOrder(maxDepth) };
+   }
+
+   /**
+   * @returns A view over all Nodes in the subtree rooted at the specified Node, in pre-order.
+   */
+   static PreOrderView Subtree(const Node& root) noexcept
+   {
+      return PreOrderView{ PreOrderIterator{ &root } };
+   }
+#endif
+
+#if defined(__cpp_impl_coroutine)
+   /**
+   * @brief Generates the Nodes of the subtree rooted at the specified Node in pre-order.
+   *
+   * Each generator is a coroutine that advances one of the Tree's own iterators every time it is
+   * resumed, so that the consumer can stop, do something else, and pick up where it left off
+   * without having to hold on to the iterator itself. The coroutine frame is drawn from a
+   * per-thread pool, or elided altogether when the compiler can see that the generator doesn't
+   * outlive its caller.
+   *
+   * As with the iterators, the structure of the subtree should not be modified while a generator
+   * is suspended in it.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const. It has to
+   *                                outlive the generator.
+   */
+   template<typename NodeType>
+   static TreeInternals::Generator<NodeType&> PreOrderGenerator(NodeType& root)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      for (auto itr = PreOrderIterator{ &root }; itr; ++itr)
+      {
+         co_yield *itr;
+      }
+   }
+
+   /**
+   * @brief Generates the Nodes of the subtree rooted at the specified Node in post-order.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const. It has to
+   *                                outlive the generator.
+   */
+   template<typename NodeType>
+   static TreeInternals::Generator<NodeType&> PostOrderGenerator(NodeType& root)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      for (auto itr = PostOrderIterator{ &root }; itr; ++itr)
+      {
+         co_yield *itr;
+      }
+   }
+
+   /**
+   * @brief Generates the leaves of the subtree rooted at the specified Node, from left to right.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const. It has to
+   *                                outlive the generator.
+   */
+   template<typename NodeType>
+   static TreeInternals::Generator<NodeType&> LeafGenerator(NodeType& root)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      for (auto itr = LeafIterator{ &root }; itr; ++itr)
+      {
+         co_yield *itr;
+      }
+   }
+
+   /**
+   * @brief Generates the Nodes of the subtree rooted at the specified Node in level-order.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const. It has to
+   *                                outlive the generator.
+   * @param[in] maxDepth            The depth, relative to the root, of the deepest level to
+   *                                generate.
+   */
+   template<typename NodeType>
+   static TreeInternals::Generator<NodeType&> LevelOrderGenerator(
+      NodeType& root,
+      unsigned int maxDepth = std::numeric_limits<unsigned int>::max())
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      for (auto itr = LevelOrderIterator{ &root, maxDepth }; itr; ++itr)
+      {
+         co_yield *itr;
+      }
+   }
+
+   /**
+   * @brief Generates the Nodes of the subtree rooted at the specified Node in pre-order, but only
+   * descends into the Nodes that the predicate approves of.
+   *
+   * The predicate is only consulted once the consumer asks for the Node that follows the one that
+   * was generated last; the Nodes it rejects are still generated, but their descendants aren't.
+   *
+   * @param[in] root                The root of the subtree to traverse; may be const. It has to
+   *                                outlive the generator.
+   * @param[in] shouldDescend       A callable type that is copied into the generator. This type
+   *                                should be equivalent to:
+   *                                   bool shouldDescend(const Node& node);
+   */
+   template<
+      typename NodeType,
+      typename PredicateType
+   >
+   static TreeInternals::Generator<NodeType&> PrunedPreOrderGenerator(
+      NodeType& root,
+      PredicateType shouldDescend)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The root of the traversal has to be a Node of this Tree.");
+
+      auto itr = PreOrderIterator{ &root };
+      while (itr)
+      {
+         co_yield *itr;
+
+         if (shouldDescend(std::as_const(*itr)))
+         {
+            ++itr;
+         }
+         else
+         {
+            itr.SkipDescendants();
+         }
+      }
+   }
+
+   /**
+   * @brief Walks two subtrees in lockstep, in pre-order, and generates pairs of corresponding
+   * Nodes, starting with the pair of roots.
+   *
+   * The children of two paired Nodes are matched up in the manner of a merge: both lists of
+   * children are assumed to be sorted by the comparator, and children that compare equivalent are
+   * paired up. A child without a counterpart is paired with nullptr, as is every Node in its
+   * subtree. This makes merging or diffing two sorted Trees a single loop.
+   *
+   * @param[in] lhs                 The root of the first subtree; may be const. It has to outlive
+   *                                the generator.
+   * @param[in] rhs                 The root of the second subtree; may be const. It has to outlive
+   *                                the generator.
+   * @param[in] isLess              A callable type that is copied into the generator. This type
+   *                                should be equivalent to:
+   *                                   bool isLess(const Node& lhs, const Node& rhs);
+   */
+   template<
+      typename NodeType,
+      typename ComparatorType
+   >
+   static TreeInternals::Generator<std::pair<NodeType*, NodeType*>> PairedPreOrderGenerator(
+      NodeType& lhs,
+      NodeType& rhs,
+      ComparatorType isLess)
+   {
+      static_assert(std::is_same_v<std::remove_const_t<NodeType>, Node>,
+         "The roots of the traversal have to be Nodes of this Tree.");
+
+      // The pairs that still have to be generated, with the next one at the back:
+      std::vector<std::pair<NodeType*, NodeType*>> pending{ { &lhs, &rhs } };
+      std::vector<std::pair<NodeType*, NodeType*>> children;
+
+      while (!pending.empty())
+      {
+         auto current = pending.back();
+         pending.pop_back();
+
+         co_yield current;
+
+         NodeType* lhsChild = current.first ? current.first->GetFirstChild() : nullptr;
+         NodeType* rhsChild = current.second ? current.second->GetFirstChild() : nullptr;
+
+         children.clear();
+         while (lhsChild || rhsChild)
+         {
+            if (!rhsChild || (lhsChild && isLess(*lhsChild, *rhsChild)))
+            {
+               children.emplace_back(lhsChild, nullptr);
+               lhsChild = lhsChild->GetNextSibling();
+            }
+            else if (!lhsChild || isLess(*rhsChild, *lhsChild))
+            {
+               children.emplace_back(nullptr, rhsChild);
+               rhsChild = rhsChild->GetNextSibling();
+            }
+            else
+            {
+               children.emplace_back(lhsChild, rhsChild);
+               lhsChild = lhsChild->GetNextSibling();
+               rhsChild = rhsChild->GetNextSibling();
+            }
+         }
+
+         pending.insert(std::end(pending), children.rbegin(), children.rend());
+      }
+   }
+
+   /**
+   * @brief Walks two subtrees in lockstep, in pre-order, pairing up children by their position
+   * among their siblings.
+   *
+   * @see PairedPreOrderGenerator(NodeType&, NodeType&, ComparatorType)
+   */
+   template<typename NodeType>
+   static TreeInternals::Generator<std::pair<NodeType*, NodeType*>> PairedPreOrderGenerator(
+      NodeType& lhs,
+      NodeType& rhs)
+   {
+      constexpr auto isLess = [] (const Node&, const Node&) noexcept { return false; };
+      return PairedPreOrderGenerator(lhs, rhs, isLess);
+   }
+#endif
+
+   /**
+   * @returns A pre-order iterator that will iterate over all Nodes in the tree.
+   */
+   inline typename Tree::PreOrderIterator beginPreOrder() const noexcept
+   {
+      const auto iterator = Tree::PreOrderIterator{ m_root };
+      return iterator;
+   }
+
+   /**
+   * @returns A pre-order iterator pointing "past" the end of the tree.
+   */
+   inline typename Tree::PreOrderIterator endPreOrder() const noexcept
+   {
+      const auto iterator = Tree::PreOrderIterator::End(m_root);
+      return iterator;
+   }
+
+   /**
+   * @returns A post-order iterator that will iterator over all nodes in the tree, starting
+   * with the root of the Tree.
+   */
+   inline typename Tree::PostOrderIterator begin() const noexcept
+   {
+      const auto iterator = Tree::PostOrderIterator{ m_root };
+      return iterator;
+   }
+
+   /**
+   * @returns A post-order iterator that points past the end of the Tree.
+   */
+   inline typename Tree::PostOrderIterator end() const noexcept
+   {
+      const auto iterator = Tree::PostOrderIterator::End(m_root);
+      return iterator;
+   }
+
+   /**
+   * @returns An iterator that will iterator over all leaf nodes in the Tree, starting with the
+   * left-most leaf in the Tree.
+   */
+   inline typename Tree::LeafIterator beginLeaf() const noexcept
+   {
+      const auto iterator = Tree::LeafIterator{ m_root };
+      return iterator;
+   }
+
+   /**
+   * @return A LeafIterator that points past the last leaf Node in the Tree.
+   */
+   inline typename Tree::LeafIterator endLeaf() const noexcept
+   {
+      const auto iterator = Tree::LeafIterator::End(m_root);
+      return iterator;
+   }
+
+   /**
+   * @returns An iterator that will iterate over all Nodes in the Tree in level-order, down to and
+   * including the specified depth.
+   */
+   inline typename Tree::LevelOrderIterator beginLevelOrder(
+      unsigned int maxDepth = std::numeric_limits<unsigned int>::max()) const
+   {
+      const auto iterator = Tree::LevelOrderIterator{ m_root, maxDepth };
+      return iterator;
+   }
+
+   /**
+   * @returns A LevelOrderIterator that points past the last Node in level-order.
+   */
+   inline typename Tree::LevelOrderIterator endLevelOrder() const noexcept
+   {
+      const auto iterator = Tree::LevelOrderIterator{ };
+      return iterator;
+   }
+
+   /**
+   * @returns A pre-order iterator that will iterate over all Nodes in the tree, while keeping
+   * up to the specified number of Nodes that could be visited soon prefetched.
+   */
+   inline auto beginPreOrderPrefetched(
+      std::size_t distance = DEFAULT_PREFETCH_DISTANCE) const noexcept
+   {
+      return PrefetchingIterator<PreOrderIterator>{ beginPreOrder(), distance };
+   }
+
+   /**
+   * @returns A prefetching pre-order iterator pointing "past" the end of the tree.
+   */
+   inline auto endPreOrderPrefetched() const noexcept
+   {
+      return PrefetchingIterator<PreOrderIterator>{ endPreOrder(), 0 };
+   }
+
+   /**
+   * @returns A post-order iterator that will iterate over all Nodes in the tree, while keeping
+   * up to the specified number of Nodes that could be visited soon prefetched.
+   */
+   inline auto beginPrefetched(std::size_t distance = DEFAULT_PREFETCH_DISTANCE) const noexcept
+   {
+      return PrefetchingIterator<PostOrderIterator>{ begin(), distance };
+   }
+
+   /**
+   * @returns A prefetching post-order iterator pointing past the end of the Tree.
+   */
+   inline auto endPrefetched() const noexcept
+   {
+      return PrefetchingIterator<PostOrderIterator>{ end(), 0 };
+   }
+
+   /**
+   * @returns A reverse iterator that will iterate over all nodes in the tree in reverse
+   * pre-order, starting with the last Node visited by a pre-order traversal.
+   */
+   inline auto rbeginPreOrder() const noexcept
+   {
+      return std::reverse_iterator<PreOrderIterator>{ endPreOrder() };
+   }
+
+   /**
+   * @returns A reverse pre-order iterator pointing "past" the root of the Tree.
+   */
+   inline auto rendPreOrder() const noexcept
+   {
+      return std::reverse_iterator<PreOrderIterator>{ beginPreOrder() };
+   }
+
+   /**
+   * @returns A reverse iterator that will iterate over all nodes in the tree in reverse
+   * post-order, starting with the root of the Tree.
+   */
+   inline auto rbegin() const noexcept
+   {
+      return std::reverse_iterator<PostOrderIterator>{ end() };
+   }
+
+   /**
+   * @returns A reverse post-order iterator pointing "past" the first Node in post-order.
+   */
+   inline auto rend() const noexcept
+   {
+      return std::reverse_iterator<PostOrderIterator>{ begin() };
+   }
+
+   /**
+   * @returns A reverse iterator that will iterate over all leaf nodes in the Tree, starting with
+   * the right-most leaf in the Tree.
+   */
+   inline auto rbeginLeaf() const noexcept
+   {
+      return std::reverse_iterator<LeafIterator>{ endLeaf() };
+   }
+
+   /**
+   * @returns A reverse LeafIterator pointing "past" the left-most leaf in the Tree.
+   */
+   inline auto rendLeaf() const noexcept
+   {
+      return std::reverse_iterator<LeafIterator>{ beginLeaf() };
+   }
+
+private:
+
+   /**
+   * @brief Folds the subtree rooted at the specified Node on the calling thread; see
+   * ParallelFoldUp.
+   *
+   * Subtrees that have already been folded are not descended into; their values are used as is.
+   * Every Node is assigned a slot, which is its position in a pre-order traversal of the subtree,
+   * where an already folded subtree takes up as many slots as it has Nodes.
+   *
+   * @param[in] findFolded          Returns the already folded subtree rooted at a Node, if any,
+   *                                given the Node and its slot. It's invoked in pre-order.
+   * @param[in] emit                Receives the slot and the value of every Node that is folded
+   *                                here, but not those of already folded subtrees, in post-order.
+   *
+   * @returns The value of the root, and the number of slots taken up by the subtree.
+   */
+   template<
+      typename NodeType,
+      typename LeafValueType,
+      typename CombineType,
+      typename FoldedLookupType,
+      typename EmitType
+   >
+   static auto FoldSubtree(
+      NodeType& root,
+      const LeafValueType& leafValue,
+      const CombineType& combine,
+      const FoldedLookupType& findFolded,
+      const EmitType& emit)
+   {
+      using ValueType = std::decay_t<decltype(leafValue(std::as_const(root)))>;
+      using FoldedType = TreeInternals::FoldedSubtree<ValueType>;
+
+      struct Entry
+      {
+         ValueType value;
+         std::size_t slot;
+         bool isFolded;
+      };
+
+      struct Folder
+      {
+         VisitResult OnEnter(NodeType& node, unsigned int)
+         {
+            if (const FoldedType* const subtree = findFolded(std::as_const(node), nextSlot))
+            {
+               open.emplace_back(Entry{ subtree->value, nextSlot, true });
+               nextSlot += subtree->size;
+
+               return VisitResult::SKIP_CHILDREN;
+            }
+
+            open.emplace_back(Entry{ leafValue(std::as_const(node)), nextSlot++, false });
+            return VisitResult::CONTINUE;
+         }
+
+         void OnExit(NodeType& node, unsigned int)
+         {
+            auto entry = std::move(open.back());
+            open.pop_back();
+
+            if (!entry.isFolded)
+            {
+               emit(node, entry.slot, std::as_const(entry.value));
+            }
+
+            if (open.empty())
+            {
+               rootValue.emplace(std::move(entry.value));
+               return;
+            }
+
+            auto& parent = open.back();
+            parent.value = combine(std::move(parent.value), std::as_const(entry.value));
+         }
+
+         const LeafValueType& leafValue;
+         const CombineType& combine;
+         const FoldedLookupType& findFolded;
+         const EmitType& emit;
+
+         std::vector<Entry> open;
+         std::size_t nextSlot;
+         std::optional<ValueType> rootValue;
+      };
+
+      Folder folder{ leafValue, combine, findFolded, emit, { }, 0, std::nullopt };
+      Walk(root, folder);
+
+      return FoldedType{ std::move(*folder.rootValue), folder.nextSlot };
+   }
+
+   /**
+   * @brief Deletes the specified Node, and makes sure that the Tree doesn't keep pointing to it.
+   */
+   void Delete(Node& node) noexcept
+   {
+      if (&node == m_root)
+      {
+         m_root = nullptr;
+      }
+
+      node.DeleteFromTree();
+   }
+
+   Node* m_root{ nullptr };
+};
+
+/**
+* The Node class represents the nodes that make up the Tree.
+*
+* Each node has a pointer to its parent, its first and last child, its previous and next
+* sibling, and, of course, to the data it encapsulates.
+*/
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::Node
+   : private TreeInternals::LeafLinks<ThreadedLeaves, Node,
+      TreeInternals::AggregateStorage<AggregatePolicy, DataType>>
+{
+   using StorageType = TreeInternals::LeafLinks<ThreadedLeaves, Node,
+      TreeInternals::AggregateStorage<AggregatePolicy, DataType>>;
+
+   friend Tree;
+
+public:
+
+   // Typedefs needed for STL compliance:
+   using value_type = DataType;
+   using reference = DataType&;
+   using const_reference = const DataType&;
+
+   /**
+   * @brief Node default constructs a new Node. All outgoing links from this new node will
+   * initialized to a nullptr.
+   */
+   constexpr Node() noexcept = default;
+
+   /**
+   * @brief Node constructs a new Node encapsulating the specified data. All outgoing links
+   * from the node will be initialized to nullptr.
+   */
+   Node(DataType data) :
+      StorageType{ data },
+      m_data{ std::move(data) }
+   {
+   }
+
+   /**
+   * @brief Node performs a copy-construction of the specified Node.
+   *
+   * The nodes in the Node are deep-copied, while the data contained in the tree is
+   * shallow-copied.
+   */
+   Node(const Node& other) :
+      StorageType{ other.m_data },
+      m_data{ other.m_data }
+   {
+      Copy(other, *this);
+   }
+
+   /**
+   * @brief Destroys the Node and all Nodes under it.
+   */
+   ~Node()
+   {
+      DetachFromTree();
+
+      if (m_childCount == 0)
+      {
+         m_parent = nullptr;
+         m_firstChild = nullptr;
+         m_lastChild = nullptr;
+         m_previousSibling = nullptr;
+         m_nextSibling = nullptr;
+
+         return;
+      }
+
+      assert(m_firstChild && m_lastChild);
+
+      Node* childNode = m_firstChild;
+      Node* nextNode = nullptr;
+
+      while (childNode != nullptr)
+      {
+         nextNode = childNode->m_nextSibling;
+
+         // This Node is going away along with its children, so there's no point in having each
+         // child unlink itself from it (or update its aggregate):
+         childNode->m_parent = nullptr;
+
+         delete childNode;
+         childNode = nextNode;
+      }
+
+      m_parent = nullptr;
+      m_firstChild = nullptr;
+      m_lastChild = nullptr;
+      m_previousSibling = nullptr;
+      m_nextSibling = nullptr;
+   }
+
+   /**
+   * @brief Assignment operator.
+   */
+   Node& operator=(Node other)
+   {
+      swap(*this, other);
+      return *this;
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is less than
+   * the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator<(const Node& lhs, const Node& rhs)
+   {
+      return lhs.GetData() < rhs.GetData();
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is less than
+   * or equal to the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator<=(const Node& lhs, const Node& rhs)
+   {
+      return !(lhs > rhs);
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is greater than
+   * the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator>(const Node& lhs, const Node& rhs)
+   {
+      return rhs < lhs;
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is greater than
+   * or equal to the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator>=(const Node& lhs, const Node& rhs)
+   {
+      return !(lhs < rhs);
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is equal to
+   * the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator==(const Node& lhs, const Node& rhs)
+   {
+      return lhs.GetData() == rhs.GetData();
+   }
+
+   /**
+   * @returns True if the data encapsulated in the left-hand side Node is not equal
+   * to the data encapsulated in the right-hand side Node.
+   */
+   friend auto operator!=(const Node& lhs, const Node& rhs)
+   {
+      return !(lhs == rhs);
+   }
+
+   /**
+   * @brief Swaps all member variables of the left-hand side with that of the right-hand side.
+   */
+   friend void swap(
+      Node& lhs,
+      Node& rhs) noexcept(noexcept(swap(lhs.m_data, rhs.m_data)))
+   {
+      // Enable Argument Dependent Lookup (ADL):
+      using std::swap;
+
+      swap(lhs.m_parent, rhs.m_parent);
+      swap(lhs.m_firstChild, rhs.m_firstChild);
+      swap(lhs.m_lastChild, rhs.m_lastChild);
+      swap(lhs.m_previousSibling, rhs.m_previousSibling);
+      swap(lhs.m_nextSibling, rhs.m_nextSibling);
+      swap(lhs.m_data, rhs.m_data);
+      swap(lhs.m_childCount, rhs.m_childCount);
+      swap(lhs.m_visited, rhs.m_visited);
+
+      // Both Nodes now hold a different list of children than before:
+      ++lhs.m_childListVersion;
+      ++rhs.m_childListVersion;
+
+      if constexpr (HAS_AGGREGATE)
+      {
+         swap(lhs.m_aggregate, rhs.m_aggregate);
+      }
+
+      if constexpr (THREADED_LEAVES)
+      {
+         swap(lhs.m_previousLeaf, rhs.m_previousLeaf);
+         swap(lhs.m_nextLeaf, rhs.m_nextLeaf);
+      }
+   }
+
+   /**
+   * @brief Detaches and then deletes the Node from the Tree it's part of.
+   */
+   inline void DeleteFromTree() noexcept
+   {
+      delete this;
+   }
+
+   /**
+   * @returns The encapsulated data.
+   */
+   inline DataType* operator->() noexcept
+   {
+      return &m_data;
+   }
+
+   /**
+   * @overload
+   */
+   inline const DataType* operator->() const noexcept
+   {
+      return &m_data;
+   }
+
+   /**
+   * @brief MarkVisited sets node visitation status.
+   *
+   * @param[in] visited             Whether the node should be marked as having been visited.
+   */
+   inline void MarkVisited(const bool visited = true) noexcept
+   {
+      m_visited = visited;
+   }
+
+   /**
+   * @returns True if the node has been marked as visited.
+   */
+   inline constexpr bool HasBeenVisited() const noexcept
+   {
+      return m_visited;
+   }
+
+   /**
+   * @brief PrependChild will prepend the specified Node as the first child of the Node.
+   *
+   * @param[in] child               The new Node to set as the first child of the Node.
+   *
+   * @returns A pointer to the newly appended child.
+   */
+   inline Node* PrependChild(Node& child) noexcept
+   {
+      child.m_parent = this;
+      ++m_childListVersion;
+
+      if (!m_firstChild)
+      {
+         return AddFirstChild(child);
+      }
+
+      assert(m_firstChild);
+
+      m_firstChild->m_previousSibling = &child;
+      m_firstChild->m_previousSibling->m_nextSibling = m_firstChild;
+      m_firstChild = m_firstChild->m_previousSibling;
+
+      m_childCount++;
+
+      PropagateAddition(child);
+      ThreadLeavesOf(child);
+
+      return m_firstChild;
+   }
+
+   /**
+   * @brief PrependChild will construct and prepend a new Node as the first child of the
+   * Node.
+   *
+   * @param[in] data                The underlying data to be stored in the new Node.
+   *
+   * @returns The newly prepended Node.
+   */
+   inline Node* PrependChild(const DataType& data)
+   {
+      const auto* newNode = new Node(data);
+      return PrependChild(*newNode);
+   }
+
+   /**
+   * @overload
+   */
+   inline Node* PrependChild(DataType&& data)
+   {
+      auto* const newNode = new Node(std::move(data));
+      return PrependChild(*newNode);
+   }
+
+   /**
+   * @brief AppendChild will append the specified Node as a child of the Node.
+   *
+   * @param[in] child               The new Node to set as the last child of the Node.
+   *
+   * @returns A pointer to the newly appended child.
+   */
+   inline Node* AppendChild(Node& child) noexcept
+   {
+      child.m_parent = this;
+      ++m_childListVersion;
+
+      if (!m_lastChild)
+      {
+         return AddFirstChild(child);
+      }
+
+      assert(m_lastChild);
+
+      m_lastChild->m_nextSibling = &child;
+      m_lastChild->m_nextSibling->m_previousSibling = m_lastChild;
+      m_lastChild = m_lastChild->m_nextSibling;
+
+      m_childCount++;
+
+      PropagateAddition(child);
+      ThreadLeavesOf(child);
+
+      return m_lastChild;
+   }
+
+   /**
+   * @brief AppendChild will construct and append a new Node as the last child of the Node.
+   *
+   * @param[in] data                The underlying data to be stored in the new Node.
+   *
+   * @returns The newly appended Node.
+   */
+   inline Node* AppendChild(const DataType& data)
+   {
+      auto* const newNode = new Node(data);
+      return AppendChild(*newNode);
+   }
+
+   /**
+   * @overload
+   */
+   inline Node* AppendChild(DataType&& data)
+   {
+      auto* const newNode = new Node(std::move(data));
+      return AppendChild(*newNode);
+   }
+
+   /**
+   * @brief SpliceChildren moves all children of the specified Node to the end of this Node's
+   * children, preserving their order.
+   *
+   * @param[in, out] donor          The Node whose children are to be moved. This Node will be
+   *                                left without any children.
+   *
+   * @complexity Linear in the number of moved children, since the parent link of each of them
+   * has to be updated. Under an aggregate policy that isn't invertible, the aggregates of the
+   * donor and its ancestors also have to be recomputed from their children.
+   */
+   void SpliceChildren(Node& donor) noexcept
+   {
+      if (&donor == this || !donor.m_firstChild)
+      {
+         return;
+      }
+
+      ++m_childListVersion;
+      ++donor.m_childListVersion;
+
+      for (auto* child = donor.m_firstChild; child; child = child->m_nextSibling)
+      {
+         child->m_parent = this;
+      }
+
+      // The leaves under the donor's children form a contiguous run of the leaf list:
+      Node* const firstMovedLeaf = THREADED_LEAVES ? donor.m_firstChild->FirstLeaf() : nullptr;
+      Node* const lastMovedLeaf = THREADED_LEAVES ? donor.m_lastChild->LastLeaf() : nullptr;
+      Node* const previousLastChild = m_lastChild;
+
+      if constexpr (HAS_AGGREGATE)
+      {
+         auto moved = donor.m_firstChild->m_aggregate;
+         for (auto* child = donor.m_firstChild->m_nextSibling; child; child = child->m_nextSibling)
+         {
+            moved = AggregatePolicy::Combine(moved, child->m_aggregate);
+         }
+
+         CombineIntoAncestry(moved);
+
+         // Under an invertible policy, the moved aggregate is simply taken out of the donor's
+         // ancestry; otherwise, that ancestry is recomputed once the children have been moved:
+         if constexpr (TreeInternals::IsInvertible<AggregatePolicy>)
+         {
+            donor.SubtractFromAncestry(moved);
+         }
+      }
+
+      if (m_lastChild)
+      {
+         m_lastChild->m_nextSibling = donor.m_firstChild;
+         donor.m_firstChild->m_previousSibling = m_lastChild;
+      }
+      else
+      {
+         m_firstChild = donor.m_firstChild;
+      }
+
+      m_lastChild = donor.m_lastChild;
+      m_childCount += donor.m_childCount;
+
+      donor.m_firstChild = nullptr;
+      donor.m_lastChild = nullptr;
+      donor.m_childCount = 0;
+
+      if constexpr (THREADED_LEAVES)
+      {
+         // The donor takes the place of the run of leaves that is moved out from under it:
+         LinkLeaves(firstMovedLeaf->m_previousLeaf, &donor);
+         LinkLeaves(&donor, lastMovedLeaf->m_nextLeaf);
+
+         Node* previous = nullptr;
+         Node* next = nullptr;
+
+         if (previousLastChild)
+         {
+            previous = previousLastChild->LastLeaf();
+            next = previous->m_nextLeaf;
+         }
+         else
+         {
+            previous = this->m_previousLeaf;
+            next = this->m_nextLeaf;
+            this->m_previousLeaf = nullptr;
+            this->m_nextLeaf = nullptr;
+         }
+
+         LinkLeaves(previous, firstMovedLeaf);
+         LinkLeaves(lastMovedLeaf, next);
+      }
+
+      if constexpr (HAS_AGGREGATE && !TreeInternals::IsInvertible<AggregatePolicy>)
+      {
+         donor.RecomputeAncestry();
+      }
+   }
+
+   /**
+   * @brief SetData replaces the underlying data stored in the Node, and updates the aggregates
+   * of the Node and all of its ancestors accordingly.
+   *
+   * @note When the Tree maintains aggregates, this is the only way in which the data of a Node
+   * should be changed; edits made through GetData() or operator-> go unnoticed.
+   *
+   * @param[in] data                The new data to be stored in the Node.
+   */
+   void SetData(DataType data)
+   {
+      if constexpr (HAS_AGGREGATE)
+      {
+         const auto previous = AggregatePolicy::Lift(m_data);
+         m_data = std::move(data);
+
+         if constexpr (TreeInternals::IsInvertible<AggregatePolicy>)
+         {
+            ReplaceInAncestry(previous, AggregatePolicy::Lift(m_data));
+         }
+         else
+         {
+            RecomputeAncestry();
+         }
+      }
+      else
+      {
+         m_data = std::move(data);
+      }
+   }
+
+   /**
+   * @returns The aggregate of the data in the subtree rooted at this Node, as maintained by the
+   * Tree's aggregate policy.
+   *
+   * @complexity Constant.
+   */
+   inline const auto& GetAggregate() const noexcept
+   {
+      static_assert(HAS_AGGREGATE, "The Tree doesn't have an aggregate policy.");
+      return this->m_aggregate;
+   }
+
+   /**
+   * @returns The leaf that precedes this leaf in the Tree's threaded leaf list, or nullptr if
+   * this is the first leaf, or not a leaf at all.
+   */
+   inline Node* GetPreviousLeaf() const noexcept
+   {
+      static_assert(THREADED_LEAVES, "The Tree doesn't thread its leaves.");
+      return this->m_previousLeaf;
+   }
+
+   /**
+   * @returns The leaf that follows this leaf in the Tree's threaded leaf list, or nullptr if this
+   * is the last leaf, or not a leaf at all.
+   */
+   inline Node* GetNextLeaf() const noexcept
+   {
+      static_assert(THREADED_LEAVES, "The Tree doesn't thread its leaves.");
+      return this->m_nextLeaf;
+   }
+
+   /**
+   * @returns The underlying data stored in the Node.
+   */
+   inline DataType& GetData() noexcept
+   {
+      return m_data;
+   }
+
+   /**
+   * @overload
+   */
+   inline const DataType& GetData() const noexcept
+   {
+      return m_data;
+   }
+
+   /**
+   * @returns A pointer to the Node's parent, if it exists; nullptr otherwise.
+   */
+   inline constexpr Node* GetParent() const
+   {
+      return m_parent;
+   }
+
+   /**
+   * @returns A pointer to the Node's first child.
+   */
+   inline constexpr Node* GetFirstChild() const
+   {
+      return m_firstChild;
+   }
+
+   /**
+   * @returns A pointer to the Node's last child.
+   */
+   inline constexpr Node* GetLastChild() const
+   {
+      return m_lastChild;
+   }
+
+   /**
+   * @returns A pointer to the Node's next sibling.
+   */
+   inline constexpr Node* GetNextSibling() const
+   {
+      return m_nextSibling;
+   }
+
+   /**
+   * @returns A pointer to the Node's previous sibling.
+   */
+   inline constexpr Node* GetPreviousSibling() const
+   {
+      return m_previousSibling;
+   }
+
+   /**
+   * @returns True if this node has direct descendants.
+   */
+   inline constexpr bool HasChildren() const noexcept
+   {
+      return m_childCount > 0;
+   }
+
+   /**
+   * @returns The number of direct descendants that this node has.
+   *
+   * @note This does not include grandchildren.
+   */
+   inline constexpr unsigned int GetChildCount() const noexcept
+   {
+      return m_childCount;
+   }
+
+   /**
+   * @returns A counter that changes whenever children are added to this Node, removed from it,
+   * or reordered, so that indices caching the structure of a Tree can tell when they've gone
+   * stale.
+   *
+   * @note The counter wraps around, so it can only tell that the list of children has changed,
+   * never how often.
+   */
+   inline constexpr std::uint16_t GetChildListVersion() const noexcept
+   {
+      return m_childListVersion;
+   }
+
+   /**
+   * @returns The total number of descendant nodes belonging to the node.
+   */
+   inline auto CountAllDescendants() noexcept
+   {
+      const auto nodeCount = std::count_if(
+         Tree::PostOrderIterator(this),
+         Tree::PostOrderIterator(),
+         [] (const auto&) noexcept
+      {
+         return true;
+      });
+
+      return nodeCount - 1;
+   }
+
+   /**
+   * @brief SortChildren performs a stable sort of the direct descendants nodes.
+   *
+   * The children are gathered into a contiguous buffer, sorted there, and then relinked in a
+   * single pass.
+   *
+   * @param[in] comparator          A callable type to be used as the basis for the sorting
+   *                                comparison. This type should be equivalent to:
+   *                                   bool comparator(
+   *                                      const Node& lhs,
+   *                                      const Node& rhs);
+   */
+   template<typename ComparatorType>
+   void SortChildren(const ComparatorType& comparator)
+   {
+      SortChildren(std::execution::seq, comparator);
+   }
+
+   /**
+   * @brief SortChildren performs a stable sort of the direct descendants nodes, with the sort
+   * itself being carried out under the specified execution policy.
+   *
+   * @param[in] policy              The execution policy that governs the parallelism.
+   * @param[in] comparator          A callable type to be used as the basis for the sorting
+   *                                comparison; see above.
+   */
+   template<
+      typename ExecutionPolicyType,
+      typename ComparatorType
+   >
+   void SortChildren(
+      ExecutionPolicyType&& policy,
+      const ComparatorType& comparator)
+   {
+      if (!m_firstChild || !m_firstChild->m_nextSibling)
+      {
+         return;
+      }
+
+      const auto bounds = GetLeafBounds();
+      SortChildList(policy, comparator);
+      StitchChildLeaves(bounds);
+   }
+
+   /**
+   * @brief SortChildrenBy performs a stable sort of the direct descendants nodes, in ascending
+   * order of the key extracted from each node.
+   *
+   * The key of each child is extracted exactly once. Integral keys are radix sorted, while all
+   * other keys are compared using operator<.
+   *
+   * @param[in] keyExtractor        A callable type that computes the sort key of a node. This type
+   *                                should be equivalent to:
+   *                                   KeyType keyExtractor(const Node& node);
+   */
+   template<typename KeyExtractorType>
+   void SortChildrenBy(const KeyExtractorType& keyExtractor)
+   {
+      using KeyType = std::decay_t<decltype(keyExtractor(std::declval<const Node&>()))>;
+
+      if (!m_firstChild || !m_firstChild->m_nextSibling)
+      {
+         return;
+      }
+
+      const auto bounds = GetLeafBounds();
+
+      if constexpr (TreeInternals::IsRadixSortable<KeyType>)
+      {
+         using RadixKeyType = decltype(TreeInternals::ToRadixKey(std::declval<KeyType>()));
+
+         std::vector<std::pair<RadixKeyType, Node*>> entries;
+         entries.reserve(m_childCount);
+
+         for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+         {
+            entries.emplace_back(TreeInternals::ToRadixKey(keyExtractor(*child)), child);
+         }
+
+         // The histogram passes only pay off once there's a decent number of keys to sort:
+         constexpr auto RADIX_SORT_THRESHOLD{ 64u };
+
+         if (entries.size() >= RADIX_SORT_THRESHOLD)
+         {
+            TreeInternals::RadixSort(entries);
+         }
+         else
+         {
+            std::stable_sort(std::begin(entries), std::end(entries),
+               [] (const auto& lhs, const auto& rhs) noexcept { return lhs.first < rhs.first; });
+         }
+
+         RelinkChildren(std::begin(entries), std::end(entries),
+            [] (const auto& entry) noexcept { return entry.second; });
+      }
+      else
+      {
+         std::vector<std::pair<KeyType, Node*>> entries;
+         entries.reserve(m_childCount);
+
+         for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+         {
+            entries.emplace_back(keyExtractor(*child), child);
+         }
+
+         std::stable_sort(std::begin(entries), std::end(entries),
+            [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+         RelinkChildren(std::begin(entries), std::end(entries),
+            [] (const auto& entry) noexcept { return entry.second; });
+      }
+
+      StitchChildLeaves(bounds);
+   }
+
+   /**
+   * @brief RemoveDescendantsIf removes every descendant that satisfies the predicate, along with
+   * its entire subtree, in a single pre-order pass.
+   *
+   * The surviving children of each Node are relinked once, no matter how many of their siblings
+   * are removed, and the predicate is never invoked on nodes inside a removed subtree. The removed
+   * nodes are freed in bulk once the pass is complete.
+   *
+   * @param[in] predicate           A callable type that selects the nodes to be removed. This type
+   *                                should be equivalent to:
+   *                                   bool predicate(const Node& node);
+   *
+   * @returns The total number of nodes removed.
+   */
+   template<typename PredicateType>
+   std::size_t RemoveDescendantsIf(const PredicateType& predicate)
+   {
+      std::vector<Node*> removed;
+
+      const auto bounds = GetLeafBounds();
+      const auto anyRemoved = PruneDescendants(predicate, removed);
+
+      if (anyRemoved && m_parent)
+      {
+         m_parent->RecomputeAncestry();
+      }
+
+      if (anyRemoved)
+      {
+         const auto leaves = ThreadSubtreeLeaves();
+         LinkLeaves(bounds.first, leaves.first);
+         LinkLeaves(leaves.second, bounds.second);
+      }
+
+      return FreeSubtrees(removed);
+   }
+
+   /**
+   * @brief RemoveDescendantsIf removes every descendant that satisfies the predicate, with the
+   * subtrees of the surviving children of this Node being pruned independently of one another,
+   * under the specified execution policy.
+   *
+   * @param[in] predicate           See above. The predicate may be invoked from several threads
+   *                                at once.
+   * @param[in] policy              The execution policy that governs the parallelism.
+   *
+   * @returns The total number of nodes removed.
+   */
+   template<
+      typename PredicateType,
+      typename ExecutionPolicyType
+   >
+   std::size_t RemoveDescendantsIf(
+      const PredicateType& predicate,
+      ExecutionPolicyType&& policy)
+   {
+      std::vector<Node*> removed;
+
+      const auto bounds = GetLeafBounds();
+      PruneChildren(predicate, removed);
+
+      std::vector<Node*> survivors;
+      survivors.reserve(m_childCount);
+
+      for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+      {
+         survivors.emplace_back(child);
+      }
+
+      const auto removedFromSubtrees = std::transform_reduce(
+         policy, std::begin(survivors), std::end(survivors), std::size_t{ 0 }, std::plus<>{ },
+         [&] (Node* child)
+      {
+         std::vector<Node*> removedFromSubtree;
+         if (child->PruneDescendants(predicate, removedFromSubtree))
+         {
+            child->ThreadSubtreeLeaves();
+         }
+
+         return FreeSubtrees(removedFromSubtree);
+      });
+
+      const auto nodesRemoved = FreeSubtrees(removed) + removedFromSubtrees;
+      if (nodesRemoved)
+      {
+         RecomputeAncestry();
+         StitchChildLeaves(bounds);
+      }
+
+      return nodesRemoved;
+   }
+
+   /**
+   * @brief TopKChildren finds the direct descendants with the largest keys, without sorting the
+   * sibling list.
+   *
+   * @param[in] k                   The maximum number of children to return.
+   * @param[in] keyExtractor        A callable type that computes the key of a node. This type
+   *                                should be equivalent to:
+   *                                   KeyType keyExtractor(const Node& node);
+   *
+   * @returns The (at most) k children with the largest keys, ordered from the largest key to
+   * the smallest.
+   */
+   template<typename KeyExtractorType>
+   std::vector<Node*> TopKChildren(
+      std::size_t k,
+      const KeyExtractorType& keyExtractor) const
+   {
+      using KeyType = std::decay_t<decltype(keyExtractor(std::declval<const Node&>()))>;
+
+      TreeInternals::BoundedHeap<KeyType, Node*> heap{ std::min<std::size_t>(k, m_childCount) };
+
+      for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+      {
+         heap.Offer(keyExtractor(*child), child);
+      }
+
+      const auto entries = heap.Extract();
+
+      std::vector<Node*> result;
+      result.reserve(entries.size());
+
+      std::transform(std::begin(entries), std::end(entries), std::back_inserter(result),
+         [] (const auto& entry) noexcept { return entry.second; });
+
+      return result;
+   }
+
+private:
+
+   /**
+   * @brief Gathers the children into a contiguous buffer, stably sorts them there, and then
+   * relinks them in a single pass; the threaded leaf list, if any, is left untouched.
+   */
+   template<
+      typename ExecutionPolicyType,
+      typename ComparatorType
+   >
+   void SortChildList(
+      ExecutionPolicyType&& policy,
+      const ComparatorType& comparator)
+   {
+      std::vector<Node*> children;
+      children.reserve(m_childCount);
+
+      for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+      {
+         children.emplace_back(child);
+      }
+
+      std::stable_sort(policy, std::begin(children), std::end(children),
+         [&] (Node* lhs, Node* rhs) { return comparator(*lhs, *rhs); });
+
+      RelinkChildren(std::begin(children), std::end(children),
+         [] (Node* child) noexcept { return child; });
+   }
+
+   /**
+   * @returns The left-most leaf in the subtree rooted at this Node.
+   */
+   inline Node* FirstLeaf() noexcept
+   {
+      auto* node = this;
+      while (node->m_firstChild)
+      {
+         node = node->m_firstChild;
+      }
+
+      return node;
+   }
+
+   /**
+   * @returns The right-most leaf in the subtree rooted at this Node.
+   */
+   inline Node* LastLeaf() noexcept
+   {
+      auto* node = this;
+      while (node->m_lastChild)
+      {
+         node = node->m_lastChild;
+      }
+
+      return node;
+   }
+
+   /**
+   * @brief Makes the two leaves adjacent in the threaded leaf list; either one may be null.
+   */
+   static void LinkLeaves(
+      Node* previous,
+      Node* next) noexcept
+   {
+      if constexpr (THREADED_LEAVES)
+      {
+         if (previous)
+         {
+            previous->m_nextLeaf = next;
+         }
+
+         if (next)
+         {
+            next->m_previousLeaf = previous;
+         }
+      }
+   }
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is greater than
-   * the data encapsulated in the right-hand side Node.
+   * @returns The leaves that immediately precede and follow the subtree rooted at this Node in
+   * the threaded leaf list; either one may be null.
    */
-   friend auto operator>(const Node& lhs, const Node& rhs)
+   std::pair<Node*, Node*> GetLeafBounds() noexcept
    {
-      return rhs < lhs;
+      if constexpr (THREADED_LEAVES)
+      {
+         return { FirstLeaf()->m_previousLeaf, LastLeaf()->m_nextLeaf };
+      }
+      else
+      {
+         return { nullptr, nullptr };
+      }
    }
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is greater than
-   * or equal to the data encapsulated in the right-hand side Node.
+   * @brief Splices the leaves of a just attached child into the threaded leaf list. The leaves
+   * of the child are expected to already be threaded amongst themselves.
+   *
+   * @param[in] child               The child that was just attached.
    */
-   friend auto operator>=(const Node& lhs, const Node& rhs)
+   void ThreadLeavesOf(Node& child) noexcept
    {
-      return !(lhs < rhs);
+      if constexpr (THREADED_LEAVES)
+      {
+         Node* previous = nullptr;
+         Node* next = nullptr;
+
+         if (m_childCount == 1)
+         {
+            // This Node used to be a leaf, and its new child takes its place:
+            previous = this->m_previousLeaf;
+            next = this->m_nextLeaf;
+
+            this->m_previousLeaf = nullptr;
+            this->m_nextLeaf = nullptr;
+         }
+         else if (child.m_previousSibling)
+         {
+            previous = child.m_previousSibling->LastLeaf();
+            next = previous->m_nextLeaf;
+         }
+         else
+         {
+            next = child.m_nextSibling->FirstLeaf();
+            previous = next->m_previousLeaf;
+         }
+
+         LinkLeaves(previous, child.FirstLeaf());
+         LinkLeaves(child.LastLeaf(), next);
+      }
    }
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is equal to
-   * the data encapsulated in the right-hand side Node.
+   * @brief Relinks the leaves under this Node's children, whose runs of leaves are expected to
+   * be threaded amongst themselves, in the current order of the children, and in between the
+   * specified bounds. A Node without children is threaded in between the bounds instead.
    */
-   friend auto operator==(const Node& lhs, const Node& rhs)
+   void StitchChildLeaves(const std::pair<Node*, Node*>& bounds) noexcept
    {
-      return lhs.GetData() == rhs.GetData();
+      if constexpr (THREADED_LEAVES)
+      {
+         if (!m_firstChild)
+         {
+            LinkLeaves(bounds.first, this);
+            LinkLeaves(this, bounds.second);
+
+            return;
+         }
+
+         Node* previous = bounds.first;
+         for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+         {
+            LinkLeaves(previous, child->FirstLeaf());
+            previous = child->LastLeaf();
+         }
+
+         LinkLeaves(previous, bounds.second);
+      }
    }
 
    /**
-   * @returns True if the data encapsulated in the left-hand side Node is not equal
-   * to the data encapsulated in the right-hand side Node.
+   * @brief Rebuilds the threaded leaf list of the subtree rooted at this Node from scratch, in a
+   * single pre-order pass over the subtree. The list is terminated at both ends.
+   *
+   * @returns The first and last leaf of the subtree.
    */
-   friend auto operator!=(const Node& lhs, const Node& rhs)
+   std::pair<Node*, Node*> ThreadSubtreeLeaves() noexcept
    {
-      return !(lhs == rhs);
+      if constexpr (THREADED_LEAVES)
+      {
+         Node* first = nullptr;
+         Node* previous = nullptr;
+
+         Tree::Traverse<TraversalOrder::PRE_ORDER>(*this, [&] (Node& node) noexcept
+         {
+            if (!node.m_firstChild)
+            {
+               node.m_previousLeaf = previous;
+               if (previous)
+               {
+                  previous->m_nextLeaf = &node;
+               }
+               else
+               {
+                  first = &node;
+               }
+
+               previous = &node;
+            }
+            else
+            {
+               node.m_previousLeaf = nullptr;
+               node.m_nextLeaf = nullptr;
+            }
+
+            return VisitResult::CONTINUE;
+         });
+
+         previous->m_nextLeaf = nullptr;
+         return { first, previous };
+      }
+      else
+      {
+         return { nullptr, nullptr };
+      }
    }
 
    /**
-   * @brief Swaps all member variables of the left-hand side with that of the right-hand side.
+   * @brief Folds the aggregate of a newly attached child into the aggregates of this Node and all
+   * of its ancestors.
+   *
+   * @param[in] child               The child that was just attached.
    */
-   friend void swap(
-      Node& lhs,
-      Node& rhs) noexcept(noexcept(swap(lhs.m_data, rhs.m_data)))
+   inline void PropagateAddition(const Node& child) noexcept
    {
-      // Enable Argument Dependent Lookup (ADL):
-      using std::swap;
+      if constexpr (HAS_AGGREGATE)
+      {
+         CombineIntoAncestry(child.m_aggregate);
+      }
+   }
 
-      swap(lhs.m_parent, rhs.m_parent);
-      swap(lhs.m_firstChild, rhs.m_firstChild);
-      swap(lhs.m_lastChild, rhs.m_lastChild);
-      swap(lhs.m_previousSibling, rhs.m_previousSibling);
-      swap(lhs.m_nextSibling, rhs.m_nextSibling);
-      swap(lhs.m_data, rhs.m_data);
-      swap(lhs.m_childCount, rhs.m_childCount);
-      swap(lhs.m_visited, rhs.m_visited);
+   /**
+   * @brief Removes the aggregate of a just detached child from the aggregates of this Node and
+   * all of its ancestors.
+   *
+   * @param[in] child               The child that was just detached.
+   */
+   inline void PropagateRemoval(const Node& child) noexcept
+   {
+      if constexpr (!HAS_AGGREGATE)
+      {
+         return;
+      }
+      else if constexpr (TreeInternals::IsInvertible<AggregatePolicy>)
+      {
+         SubtractFromAncestry(child.m_aggregate);
+      }
+      else
+      {
+         RecomputeAncestry();
+      }
    }
 
    /**
-   * @brief Detaches and then deletes the Node from the Tree it's part of.
+   * @brief Combines the specified value into the aggregates of this Node and all of its
+   * ancestors.
+   *
+   * @complexity Linear in the depth of the Node.
    */
-   inline void DeleteFromTree() noexcept
+   template<typename ValueType>
+   void CombineIntoAncestry(const ValueType& value) noexcept
    {
-      delete this;
+      for (auto* node = this; node; node = node->m_parent)
+      {
+         node->m_aggregate = AggregatePolicy::Combine(node->m_aggregate, value);
+      }
    }
 
    /**
-   * @returns The encapsulated data.
+   * @brief Removes the specified value from the aggregates of this Node and all of its ancestors;
+   * only possible under an invertible aggregate policy.
+   *
+   * @complexity Linear in the depth of the Node.
    */
-   inline DataType* operator->() noexcept
+   template<typename ValueType>
+   void SubtractFromAncestry(const ValueType& value) noexcept
    {
-      return &m_data;
+      for (auto* node = this; node; node = node->m_parent)
+      {
+         node->m_aggregate = AggregatePolicy::Subtract(node->m_aggregate, value);
+      }
    }
 
    /**
-   * @overload
+   * @brief Swaps one contribution to the aggregates of this Node and all of its ancestors for
+   * another; only possible under an invertible aggregate policy.
+   *
+   * @complexity Linear in the depth of the Node.
    */
-   inline const DataType* operator->() const noexcept
+   template<typename ValueType>
+   void ReplaceInAncestry(
+      const ValueType& previous,
+      const ValueType& current) noexcept
    {
-      return &m_data;
+      for (auto* node = this; node; node = node->m_parent)
+      {
+         node->m_aggregate = AggregatePolicy::Combine(
+            AggregatePolicy::Subtract(node->m_aggregate, previous), current);
+      }
    }
 
    /**
-   * @brief MarkVisited sets node visitation status.
+   * @brief Recomputes the aggregates of this Node and all of its ancestors from their data and
+   * the aggregates of their children; this is how removals are handled under aggregate policies
+   * that cannot undo a Combine operation.
    *
-   * @param[in] visited             Whether the node should be marked as having been visited.
+   * @complexity Linear in the number of children of the Node and all of its ancestors.
    */
-   inline void MarkVisited(const bool visited = true) noexcept
+   void RecomputeAncestry() noexcept
    {
-      m_visited = visited;
+      if constexpr (HAS_AGGREGATE)
+      {
+         for (auto* node = this; node; node = node->m_parent)
+         {
+            node->RecomputeAggregate();
+         }
+      }
    }
 
    /**
-   * @returns True if the node has been marked as visited.
+   * @brief Recomputes the aggregate of this Node alone from its data and the aggregates of its
+   * children.
    */
-   inline constexpr bool HasBeenVisited() const noexcept
+   inline void RecomputeAggregate() noexcept
    {
-      return m_visited;
+      if constexpr (HAS_AGGREGATE)
+      {
+         auto aggregate = AggregatePolicy::Lift(m_data);
+         for (auto* child = m_firstChild; child; child = child->m_nextSibling)
+         {
+            aggregate = AggregatePolicy::Combine(aggregate, child->m_aggregate);
+         }
+
+         this->m_aggregate = std::move(aggregate);
+      }
    }
 
    /**
-   * @brief PrependChild will prepend the specified Node as the first child of the Node.
+   * @brief Unlinks all children that satisfy the predicate, while relinking the surviving
+   * children in the same pass.
    *
-   * @param[in] child               The new Node to set as the first child of the Node.
+   * @param[in] predicate           The predicate that selects the children to be removed.
+   * @param[out] removed            The unlinked children are appended to this buffer.
    *
-   * @returns A pointer to the newly appended child.
+   * @returns True if any child was unlinked.
    */
-   inline Node* PrependChild(Node& child) noexcept
+   template<typename PredicateType>
+   bool PruneChildren(
+      const PredicateType& predicate,
+      std::vector<Node*>& removed)
    {
-      child.m_parent = this;
+      const auto previouslyRemoved = removed.size();
 
-      if (!m_firstChild)
+      Node* child = m_firstChild;
+      Node* previous = nullptr;
+
+      m_firstChild = nullptr;
+
+      while (child)
       {
-         return AddFirstChild(child);
+         Node* const next = child->m_nextSibling;
+
+         if (predicate(*child))
+         {
+            child->m_parent = nullptr;
+            child->m_previousSibling = nullptr;
+            child->m_nextSibling = nullptr;
+
+            removed.emplace_back(child);
+            m_childCount--;
+         }
+         else
+         {
+            child->m_previousSibling = previous;
+
+            if (previous)
+            {
+               previous->m_nextSibling = child;
+            }
+            else
+            {
+               m_firstChild = child;
+            }
+
+            previous = child;
+         }
+
+         child = next;
       }
 
-      assert(m_firstChild);
+      if (previous)
+      {
+         previous->m_nextSibling = nullptr;
+      }
 
-      m_firstChild->m_previousSibling = &child;
-      m_firstChild->m_previousSibling->m_nextSibling = m_firstChild;
-      m_firstChild = m_firstChild->m_previousSibling;
+      m_lastChild = previous;
 
-      m_childCount++;
+      const auto anyRemoved = removed.size() != previouslyRemoved;
+      if (anyRemoved)
+      {
+         ++m_childListVersion;
+      }
 
-      return m_firstChild;
+      return anyRemoved;
    }
 
    /**
-   * @brief PrependChild will construct and prepend a new Node as the first child of the
-   * Node.
+   * @brief Unlinks all descendants that satisfy the predicate, without descending into the
+   * subtrees of unlinked nodes. The aggregates of the nodes in this subtree are kept up to date,
+   * but those of this Node's ancestors are not.
    *
-   * @param[in] data                The underlying data to be stored in the new Node.
+   * @param[in] predicate           The predicate that selects the nodes to be removed.
+   * @param[out] removed            The unlinked nodes are appended to this buffer.
    *
-   * @returns The newly prepended Node.
+   * @returns True if any descendant was unlinked.
    */
-   inline Node* PrependChild(const DataType& data)
+   template<typename PredicateType>
+   bool PruneDescendants(
+      const PredicateType& predicate,
+      std::vector<Node*>& removed)
    {
-      const auto* newNode = new Node(data);
-      return PrependChild(*newNode);
+      // The subtree is walked iteratively, so that deep Trees can't overflow the stack. A Node's
+      // children are pruned as it is entered, which is before the walk looks at them, and its
+      // aggregate is recomputed on the way back up if anything underneath it was removed:
+      struct Pruner
+      {
+         VisitResult OnEnter(Node& node, unsigned int)
+         {
+            changed.emplace_back(node.PruneChildren(predicate, removed));
+            return VisitResult::CONTINUE;
+         }
+
+         void OnExit(Node& node, unsigned int)
+         {
+            const bool anyRemoved = changed.back();
+            changed.pop_back();
+
+            if (!anyRemoved)
+            {
+               return;
+            }
+
+            node.RecomputeAggregate();
+
+            if (changed.empty())
+            {
+               anyRemovedOverall = true;
+            }
+            else
+            {
+               changed.back() = true;
+            }
+         }
+
+         const PredicateType& predicate;
+         std::vector<Node*>& removed;
+
+         std::vector<bool> changed;
+         bool anyRemovedOverall;
+      };
+
+      Pruner pruner{ predicate, removed, { }, false };
+      Tree::Walk(*this, pruner);
+
+      return pruner.anyRemovedOverall;
    }
 
    /**
-   * @overload
+   * @brief Frees the specified, already unlinked, subtrees.
+   *
+   * @returns The total number of nodes freed.
    */
-   inline Node* PrependChild(DataType&& data)
+   static std::size_t FreeSubtrees(const std::vector<Node*>& subtrees) noexcept
    {
-      auto* const newNode = new Node(std::move(data));
-      return PrependChild(*newNode);
+      std::size_t nodeCount{ 0 };
+
+      for (auto* subtree : subtrees)
+      {
+         nodeCount += static_cast<std::size_t>(subtree->CountAllDescendants()) + 1;
+         delete subtree;
+      }
+
+      return nodeCount;
+   }
+
+   /**
+   * @brief RelinkChildren rebuilds the child list of this Node so that it matches the order of
+   * the specified range.
+   *
+   * @param[in] begin               The beginning of the range containing all children.
+   * @param[in] end                 The end of the range containing all children.
+   * @param[in] toNode              A callable type that maps an element of the range onto the
+   *                                child Node that it represents.
+   */
+   template<
+      typename IteratorType,
+      typename ProjectionType
+   >
+   void RelinkChildren(
+      IteratorType begin,
+      IteratorType end,
+      const ProjectionType& toNode) noexcept
+   {
+      ++m_childListVersion;
+
+      Node* previous = nullptr;
+
+      for (auto itr = begin; itr != end; ++itr)
+      {
+         Node* const child = toNode(*itr);
+
+         child->m_parent = this;
+         child->m_previousSibling = previous;
+
+         if (previous)
+         {
+            previous->m_nextSibling = child;
+         }
+         else
+         {
+            m_firstChild = child;
+         }
+
+         previous = child;
+      }
+
+      if (previous)
+      {
+         previous->m_nextSibling = nullptr;
+      }
+
+      m_lastChild = previous;
+   }
+
+   /**
+   * @brief AddFirstChild is a helper function to make it easier to add the first descendant.
+   *
+   * @param[in] child               The Node to be added as a child.
+   *
+   * @returns The newly added node.
+   */
+   inline Node* AddFirstChild(Node& child) noexcept
+   {
+      assert(m_childCount == 0);
+
+      m_firstChild = &child;
+      m_lastChild = m_firstChild;
+
+      m_childCount++;
+
+      PropagateAddition(child);
+      ThreadLeavesOf(child);
+
+      return m_firstChild;
+   }
+
+   /**
+   * @brief Helper function to recursively copy the specified |source| Node and all its
+   * descendants.
+   *
+   * @param[in] source              The Node to copy information from.
+   * @param[out] sink               The Node to place a copy of the information into.
+   */
+   void Copy(
+      const Node& source,
+      Node& sink)
+   {
+      if (!source.HasChildren())
+      {
+         return;
+      }
+
+      std::for_each(
+         Tree::SiblingIterator(source.GetFirstChild()),
+         Tree::SiblingIterator(),
+         [&] (Tree::const_reference node)
+      {
+         sink.AppendChild(node.GetData());
+      });
+
+      auto sourceItr = Tree::SiblingIterator{ source.GetFirstChild() };
+      auto sinkItr = Tree::SiblingIterator{ sink.GetFirstChild() };
+
+      const auto end = Tree::SiblingIterator{};
+      while (sourceItr != end)
+      {
+         Copy(*sourceItr++, *sinkItr++);
+      }
    }
 
    /**
-   * @brief AppendChild will append the specified Node as a child of the Node.
+   * @brief Removes the Node from the tree structure, updating all surrounding links
+   * as appropriate.
    *
-   * @param[in] child               The new Node to set as the last child of the Node.
+   * @note This function does not actually delete the node.
    *
-   * @returns A pointer to the newly appended child.
+   * @returns A pointer to the detached Node. This returned Node can safely be deleted
+   * once detached.
    */
-   inline Node* AppendChild(Node& child) noexcept
+   Node* DetachFromTree() noexcept
    {
-      child.m_parent = this;
+      if (m_previousSibling && m_nextSibling)
+      {
+         m_previousSibling->m_nextSibling = m_nextSibling;
+         m_nextSibling->m_previousSibling = m_previousSibling;
+      }
+      else if (m_previousSibling)
+      {
+         m_previousSibling->m_nextSibling = nullptr;
+      }
+      else if (m_nextSibling)
+      {
+         m_nextSibling->m_previousSibling = nullptr;
+      }
 
-      if (!m_lastChild)
+      if (!m_parent)
       {
-         return AddFirstChild(child);
+         return this;
       }
 
-      assert(m_lastChild);
+      ++m_parent->m_childListVersion;
 
-      m_lastChild->m_nextSibling = &child;
-      m_lastChild->m_nextSibling->m_previousSibling = m_lastChild;
-      m_lastChild = m_lastChild->m_nextSibling;
+      if (m_parent->m_firstChild == m_parent->m_lastChild)
+      {
+         m_parent->m_firstChild = nullptr;
+         m_parent->m_lastChild = nullptr;
+      }
+      else if (m_parent->m_firstChild == this)
+      {
+         assert(m_parent->m_firstChild->m_nextSibling);
+         m_parent->m_firstChild = m_parent->m_firstChild->m_nextSibling;
+      }
+      else if (m_parent->m_lastChild == this)
+      {
+         assert(m_parent->m_lastChild->m_previousSibling);
+         m_parent->m_lastChild = m_parent->m_lastChild->m_previousSibling;
+      }
 
-      m_childCount++;
+      m_parent->m_childCount--;
 
-      return m_lastChild;
-   }
+      m_parent->PropagateRemoval(*this);
 
-   /**
-   * @brief AppendChild will construct and append a new Node as the last child of the Node.
-   *
-   * @param[in] data                The underlying data to be stored in the new Node.
-   *
-   * @returns The newly appended Node.
-   */
-   inline Node* AppendChild(const DataType& data)
-   {
-      auto* const newNode = new Node(data);
-      return AppendChild(*newNode);
-   }
+      if constexpr (THREADED_LEAVES)
+      {
+         Node* const firstLeaf = FirstLeaf();
+         Node* const lastLeaf = LastLeaf();
 
-   /**
-   * @overload
-   */
-   inline Node* AppendChild(DataType&& data)
-   {
-      auto* const newNode = new Node(std::move(data));
-      return AppendChild(*newNode);
-   }
+         Node* const previous = firstLeaf->m_previousLeaf;
+         Node* const next = lastLeaf->m_nextLeaf;
 
-   /**
-   * @returns The underlying data stored in the Node.
-   */
-   inline DataType& GetData() noexcept
-   {
-      return m_data;
-   }
+         firstLeaf->m_previousLeaf = nullptr;
+         lastLeaf->m_nextLeaf = nullptr;
 
-   /**
-   * @overload
-   */
-   inline const DataType& GetData() const noexcept
-   {
-      return m_data;
-   }
+         // A parent that is left without children becomes a leaf in its own right:
+         if (m_parent->m_childCount == 0)
+         {
+            LinkLeaves(previous, m_parent);
+            LinkLeaves(m_parent, next);
+         }
+         else
+         {
+            LinkLeaves(previous, next);
+         }
+      }
 
-   /**
-   * @returns A pointer to the Node's parent, if it exists; nullptr otherwise.
-   */
-   inline constexpr Node* GetParent() const
-   {
-      return m_parent;
+      return this;
    }
 
+   Node* m_parent{ nullptr };
+   Node* m_firstChild{ nullptr };
+   Node* m_lastChild{ nullptr };
+   Node* m_previousSibling{ nullptr };
+   Node* m_nextSibling{ nullptr };
+
+   DataType m_data{ };
+
+   unsigned int m_childCount{ 0 };
+
+   // Sixteen bits fit into the padding after the child count, so this costs nothing per Node:
+   std::uint16_t m_childListVersion{ 0 };
+
+   bool m_visited{ false };
+};
+
+/**
+* @brief The Iterator class
+*
+* This is the base iterator class that all other iterators (sibling, leaf, post-, pre-, and
+* in-order) will derive from. This class can only instantiated by derived types.
+*
+* Besides the current Node, an iterator only remembers the root of the subtree that it traverses;
+* rather than precomputing the Node that follows the traversal, each increment checks whether it
+* is about to leave that subtree. The end of a traversal is reached once the current Node is null,
+* which is also what the Tree::Sentinel compares equal to.
+*/
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
+{
+public:
+
+   // Typedefs needed for STL compliance; note that iterators dereference to the Node, and not to
+   // the data it encapsulates:
+   using value_type = Node;
+   using pointer = Node*;
+   using reference = Node&;
+   using const_reference = const Node&;
+   using size_type = std::size_t;
+   using difference_type = std::ptrdiff_t;
+   using iterator_category = std::forward_iterator_tag;
+
    /**
-   * @returns A pointer to the Node's first child.
+   * @returns True if the Tree::Iterator points to a valid Node; false otherwise.
    */
-   inline constexpr Node* GetFirstChild() const
+   explicit operator bool() const noexcept
    {
-      return m_firstChild;
+      const auto isValid = (m_currentNode != nullptr);
+      return isValid;
    }
 
    /**
-   * @returns A pointer to the Node's last child.
+   * @returns The Node pointed to by the Tree::Iterator. As with a pointer, the constness of the
+   * iterator doesn't carry over to the Node.
    */
-   inline constexpr Node* GetLastChild() const
+   inline Node& operator*() const noexcept
    {
-      return m_lastChild;
+      return *m_currentNode;
    }
 
    /**
-   * @returns A pointer to the Node's next sibling.
+   * @returns A pointer to the Node.
    */
-   inline constexpr Node* GetNextSibling() const
+   inline Node* operator&() noexcept
    {
-      return m_nextSibling;
+      return m_currentNode;
    }
 
    /**
-   * @returns A pointer to the Node's previous sibling.
+   * @overload
    */
-   inline constexpr Node* GetPreviousSibling() const
+   inline const Node* operator&() const noexcept
    {
-      return m_previousSibling;
+      return m_currentNode;
    }
 
    /**
-   * @returns True if this node has direct descendants.
+   * @returns A pointer to the Node pointed to by the Tree:Iterator.
    */
-   inline constexpr bool HasChildren() const noexcept
+   inline Node* operator->() const noexcept
    {
-      return m_childCount > 0;
+      return m_currentNode;
    }
 
    /**
-   * @returns The number of direct descendants that this node has.
-   *
-   * @note This does not include grandchildren.
+   * @returns True if the Iterator points to the same node as the other Iterator,
+   * and false otherwise.
    */
-   inline constexpr unsigned int GetChildCount() const noexcept
+   inline bool operator==(const Iterator& other) const
    {
-      return m_childCount;
+      return m_currentNode == other.m_currentNode;
    }
 
    /**
-   * @returns The total number of descendant nodes belonging to the node.
+   * @returns True if the Iterator points to the same node as the other Iterator,
+   * and false otherwise.
    */
-   inline auto CountAllDescendants() noexcept
+   bool operator!=(const Iterator& other) const noexcept
    {
-      const auto nodeCount = std::count_if(
-         Tree<DataType>::PostOrderIterator(this),
-         Tree<DataType>::PostOrderIterator(),
-         [] (const auto&) noexcept
-      {
-         return true;
-      });
-
-      return nodeCount - 1;
+      return m_currentNode != other.m_currentNode;
    }
 
    /**
-   * @brief SortChildren performs a merge sort of the direct descendants nodes.
-   *
-   * @param[in] comparator          A callable type to be used as the basis for the sorting
-   *                                comparison. This type should be equivalent to:
-   *                                   bool comparator(
-   *                                      const Node& lhs,
-   *                                      const Node& rhs);
+   * @returns True if the Iterator has run past the end of its traversal.
    */
-   template<typename ComparatorType>
-   void SortChildren(const ComparatorType& comparator) noexcept(noexcept(comparator))
+   friend bool operator==(const Iterator& itr, Sentinel) noexcept
    {
-      if (!m_firstChild)
-      {
-         return;
-      }
-
-      MergeSort(m_firstChild, comparator);
+      return itr.m_currentNode == nullptr;
    }
 
-private:
-
    /**
-   * @brief MergeSort is the main entry point into the merge sort implementation.
-   *
-   * @param[in] list                The first Node in the list to be sorted.
-   * @param[in] comparator          The comparator function to be called to figure out which node
-   *                                is the lesser of the two.
+   * @overload
    */
-   template<typename ComparatorType>
-   void MergeSort(
-      Node*& list,
-      const ComparatorType& comparator) noexcept(noexcept(comparator))
+   friend bool operator==(Sentinel, const Iterator& itr) noexcept
    {
-      if (!list || !list->m_nextSibling)
-      {
-         return;
-      }
-
-      Node* root = list;
-      Node* lhs = nullptr;
-      Node* rhs = nullptr;
-
-      DivideList(root, lhs, rhs);
-
-      assert(lhs);
-      assert(rhs);
-
-      MergeSort(lhs, comparator);
-      MergeSort(rhs, comparator);
-
-      list = MergeSortedHalves(lhs, rhs, comparator);
+      return itr.m_currentNode == nullptr;
    }
 
    /**
-   * @brief DivideList is a helper function that will divide the specified Node list in two.
-   *
-   * @param[in] root                The root of the Node list to be divided in two.
-   * @param[out] lhs                The first Node of the left hand side list.
-   * @param[out] rhs                The first Node of the right hand side list.
+   * @returns True if the Iterator still points to a Node of its traversal.
    */
-   void DivideList(
-      Node* root,
-      Node*& lhs,
-      Node*& rhs) noexcept
+   friend bool operator!=(const Iterator& itr, Sentinel) noexcept
    {
-      if (!root || !root->m_nextSibling)
-      {
-         return;
-      }
-
-      Node* tortoise = root;
-      Node* hare = root->m_nextSibling;
-
-      while (hare)
-      {
-         hare = hare->m_nextSibling;
-         if (hare)
-         {
-            tortoise = tortoise->m_nextSibling;
-            hare = hare->m_nextSibling;
-         }
-      }
-
-      lhs = root;
-      rhs = tortoise->m_nextSibling;
-
-      tortoise->m_nextSibling = nullptr;
+      return itr.m_currentNode != nullptr;
    }
 
    /**
-   * @brief MergeSortedHalves is a helper function that will merge the sorted halves.
-   *
-   * @param[in] lhs                 The first node of the sorted left half.
-   * @param[in] rhs                 The first node of the sorted right half.
-   *
-   * @returns The first node of the merged Node list.
+   * @overload
    */
-   template<typename ComparatorType>
-   Node* MergeSortedHalves(
-      Node*& lhs,
-      Node*& rhs,
-      const ComparatorType& comparator) noexcept(noexcept(comparator))
+   friend bool operator!=(Sentinel, const Iterator& itr) noexcept
    {
-      Node* result = nullptr;
-      if (comparator(*lhs, *rhs))
-      {
-         result = lhs;
-         lhs = lhs->m_nextSibling;
-      }
-      else
-      {
-         result = rhs;
-         rhs = rhs->m_nextSibling;
-      }
-
-      result->m_previousSibling = nullptr;
-
-      Node* tail = result;
-
-      while (lhs && rhs)
-      {
-         if (comparator(*lhs, *rhs))
-         {
-            tail->m_nextSibling = lhs;
-            tail = tail->m_nextSibling;
-
-            lhs = lhs->m_nextSibling;
-
-            if (lhs)
-            {
-               lhs->m_previousSibling = nullptr;
-            }
-         }
-         else
-         {
-            tail->m_nextSibling = rhs;
-            tail = tail->m_nextSibling;
-
-            rhs = rhs->m_nextSibling;
-
-            if (rhs)
-            {
-               rhs->m_previousSibling = nullptr;
-            }
-         }
-      }
+      return itr.m_currentNode != nullptr;
+   }
 
-      while (lhs)
-      {
-         tail->m_nextSibling = lhs;
-         tail = tail->m_nextSibling;
+protected:
 
-         lhs = lhs->m_nextSibling;
+   /**
+   * Default constructor.
+   */
+   Iterator() noexcept = default;
 
-         if (lhs)
-         {
-            lhs->m_previousSibling = nullptr;
-         }
-      }
+   /**
+   * Constructs a Iterator started at the specified node.
+   */
+   explicit Iterator(const Node* node) noexcept :
+      m_currentNode{ const_cast<Node*>(node) },
+      m_rootNode{ node }
+   {
+   }
 
-      while (rhs)
+   /**
+   * @returns The first Node, in post-order, of the subtree rooted at the specified Node.
+   */
+   static Node* FirstDescendant(const Node* node) noexcept
+   {
+      while (node->GetFirstChild())
       {
-         tail->m_nextSibling = rhs;
-         tail = tail->m_nextSibling;
-
-         rhs = rhs->m_nextSibling;
-
-         if (rhs)
-         {
-            rhs->m_previousSibling = nullptr;
-         }
+         node = node->GetFirstChild();
       }
 
-      return result;
+      return const_cast<Node*>(node);
    }
 
    /**
-   * @brief AddFirstChild is a helper function to make it easier to add the first descendant.
-   *
-   * @param[in] child               The Node to be added as a child.
-   *
-   * @returns The newly added node.
+   * @returns The last Node, in pre-order, of the subtree rooted at the specified Node.
    */
-   inline Node* AddFirstChild(Node& child) noexcept
+   static Node* LastDescendant(const Node* node) noexcept
    {
-      assert(m_childCount == 0);
-
-      m_firstChild = &child;
-      m_lastChild = m_firstChild;
-
-      m_childCount++;
+      while (node->GetLastChild())
+      {
+         node = node->GetLastChild();
+      }
 
-      return m_firstChild;
+      return const_cast<Node*>(node);
    }
 
    /**
-   * @brief Helper function to recursively copy the specified |source| Node and all its
-   * descendants.
-   *
-   * @param[in] source              The Node to copy information from.
-   * @param[out] sink               The Node to place a copy of the information into.
+   * @returns The closest ancestor-or-self of the specified Node that has a next sibling, without
+   * leaving the subtree being traversed, or nullptr if there is no such Node.
    */
-   void Copy(
-      const Node& source,
-      Node& sink)
+   const Node* ClimbToNextSibling(const Node* node) const noexcept
    {
-      if (!source.HasChildren())
+      while (node != m_rootNode && !node->GetNextSibling())
       {
-         return;
+         node = node->GetParent();
       }
 
-      std::for_each(
-         Tree<DataType>::SiblingIterator(source.GetFirstChild()),
-         Tree<DataType>::SiblingIterator(),
-         [&] (Tree<DataType>::const_reference node)
-      {
-         sink.AppendChild(node.GetData());
-      });
-
-      auto sourceItr = Tree<DataType>::SiblingIterator{ source.GetFirstChild() };
-      auto sinkItr = Tree<DataType>::SiblingIterator{ sink.GetFirstChild() };
+      return (node != m_rootNode) ? node->GetNextSibling() : nullptr;
+   }
 
-      const auto end = Tree<DataType>::SiblingIterator{};
-      while (sourceItr != end)
+   /**
+   * @returns The closest ancestor-or-self of the specified Node that has a previous sibling,
+   * without leaving the subtree being traversed.
+   */
+   const Node* ClimbToPreviousSibling(const Node* node) const noexcept
+   {
+      while (node != m_rootNode && !node->GetPreviousSibling())
       {
-         Copy(*sourceItr++, *sinkItr++);
+         node = node->GetParent();
       }
+
+      assert(node != m_rootNode);
+      return node->GetPreviousSibling();
    }
 
    /**
-   * @brief Removes the Node from the tree structure, updating all surrounding links
-   * as appropriate.
-   *
-   * @note This function does not actually delete the node.
+   * @brief Writes an entry for each of the next Nodes that the iterator visits into the buffer,
+   * until either the buffer is full or the traversal has ended. Depending on the type of the
+   * buffer, each entry points either to a Node or to its data.
    *
-   * @returns A pointer to the detached Node. This returned Node can safely be deleted
-   * once detached.
+   * @returns The number of entries written.
    */
-   Node* DetachFromTree() noexcept
+   template<
+      typename IteratorType,
+      typename PointerType
+   >
+   static std::size_t FillBatch(
+      IteratorType& itr,
+      PointerType* buffer,
+      std::size_t capacity)
    {
-      if (m_previousSibling && m_nextSibling)
-      {
-         m_previousSibling->m_nextSibling = m_nextSibling;
-         m_nextSibling->m_previousSibling = m_previousSibling;
-      }
-      else if (m_previousSibling)
+      std::size_t count{ 0 };
+      for (; count < capacity && itr; ++count, ++itr)
       {
-         m_previousSibling->m_nextSibling = nullptr;
-      }
-      else if (m_nextSibling)
-      {
-         m_nextSibling->m_previousSibling = nullptr;
+         buffer[count] = ToBatchEntry<PointerType>(std::addressof(*itr));
       }
 
-      if (!m_parent)
-      {
-         return this;
-      }
+      return count;
+   }
 
-      if (m_parent->m_firstChild == m_parent->m_lastChild)
-      {
-         m_parent->m_firstChild = nullptr;
-         m_parent->m_lastChild = nullptr;
-      }
-      else if (m_parent->m_firstChild == this)
+   /**
+   * @returns A pointer to the specified Node, or to its data, depending on the type of the entry.
+   */
+   template<typename PointerType>
+   static PointerType ToBatchEntry(Node* node) noexcept
+   {
+      if constexpr (std::is_convertible_v<Node*, PointerType>)
       {
-         assert(m_parent->m_firstChild->m_nextSibling);
-         m_parent->m_firstChild = m_parent->m_firstChild->m_nextSibling;
+         return node;
       }
-      else if (m_parent->m_lastChild == this)
+      else
       {
-         assert(m_parent->m_lastChild->m_previousSibling);
-         m_parent->m_lastChild = m_parent->m_lastChild->m_previousSibling;
-      }
-
-      m_parent->m_childCount--;
+         static_assert(std::is_convertible_v<DataType*, PointerType>,
+            "A batch can only hold pointers to Nodes, or to the data they hold.");
 
-      return this;
+         return std::addressof(node->GetData());
+      }
    }
 
-   Node* m_parent{ nullptr };
-   Node* m_firstChild{ nullptr };
-   Node* m_lastChild{ nullptr };
-   Node* m_previousSibling{ nullptr };
-   Node* m_nextSibling{ nullptr };
-
-   DataType m_data{ };
-
-   unsigned int m_childCount{ 0 };
+   Node* m_currentNode{ nullptr };
 
-   bool m_visited{ false };
+   const Node* m_rootNode{ nullptr };
 };
 
 /**
-* @brief The Iterator class
-*
-* This is the base iterator class that all other iterators (sibling, leaf, post-, pre-, and
-* in-order) will derive from. This class can only instantiated by derived types.
+* @brief The PreOrderIterator class
 */
-template<typename DataType>
-class Tree<DataType>::Iterator
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::PreOrderIterator final
+   : public Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
 {
 public:
 
-   // Typedefs needed for STL compliance:
-   using value_type = DataType;
-   using pointer = DataType*;
-   using reference = DataType&;
-   using const_reference = const reference;
-   using size_type = std::size_t;
-   using difference_type = std::ptrdiff_t;
-   using iterator_category = std::forward_iterator_tag;
+   using iterator_category = std::bidirectional_iterator_tag;
 
    /**
-   * @returns True if the Tree::Iterator points to a valid Node; false otherwise.
+   * Default constructor.
    */
-   explicit operator bool() const noexcept
+   PreOrderIterator() noexcept = default;
+
+   /**
+   * Constructs an iterator that traverses the subtree rooted at the specified node, starting
+   * with that node.
+   */
+   explicit PreOrderIterator(const Node* node) noexcept :
+      Iterator{ node }
    {
-      const auto isValid = (m_currentNode != nullptr);
-      return isValid;
    }
 
    /**
-   * @returns The Node pointed to by the Tree::Iterator.
+   * Prefix increment operator.
    */
-   inline Node& operator*() noexcept
+   typename Tree::PreOrderIterator& operator++() noexcept
    {
-      return *m_currentNode;
+      assert(this->m_currentNode);
+
+      if (this->m_currentNode->HasChildren())
+      {
+         this->m_currentNode = this->m_currentNode->GetFirstChild();
+         return *this;
+      }
+
+      return SkipDescendants();
    }
 
    /**
-   * @overload
+   * @brief Advances the iterator to the next node, in pre-order, that isn't a descendant of the
+   * current node.
    */
-   inline const Node& operator*() const noexcept
+   typename Tree::PreOrderIterator& SkipDescendants() noexcept
    {
-      return *m_currentNode;
+      assert(this->m_currentNode);
+
+      this->m_currentNode = const_cast<Node*>(this->ClimbToNextSibling(this->m_currentNode));
+      return *this;
    }
 
    /**
-   * @returns A pointer to the Node.
+   * Postfix increment operator.
    */
-   inline Node* operator&() noexcept
+   typename Tree::PreOrderIterator operator++(int) noexcept
    {
-      return m_currentNode;
+      const auto result = *this;
+      ++(*this);
+
+      return result;
    }
 
    /**
-   * @overload
+   * Prefix decrement operator.
    */
-   inline const Node* operator&() const noexcept
+   typename Tree::PreOrderIterator& operator--() noexcept
    {
-      return m_currentNode;
+      assert(this->m_currentNode != this->m_rootNode);
+      auto* traversingNode = this->m_currentNode;
+
+      if (!traversingNode)
+      {
+         assert(this->m_rootNode);
+         traversingNode = this->LastDescendant(this->m_rootNode);
+      }
+      else if (traversingNode->GetPreviousSibling())
+      {
+         traversingNode = this->LastDescendant(traversingNode->GetPreviousSibling());
+      }
+      else
+      {
+         traversingNode = traversingNode->GetParent();
+      }
+
+      this->m_currentNode = traversingNode;
+      return *this;
    }
 
    /**
-   * @returns A pointer to the Node pointed to by the Tree:Iterator.
+   * Postfix decrement operator.
    */
-   inline Node* operator->() noexcept
+   typename Tree::PreOrderIterator operator--(int) noexcept
    {
-      return m_currentNode;
+      const auto result = *this;
+      --(*this);
+
+      return result;
    }
 
    /**
-   * @overload
+   * @brief Copies pointers to the next Nodes of the traversal into the buffer, and advances the
+   * iterator past them.
+   *
+   * Filling a buffer in one go keeps the pointer chasing out of whatever loop processes the
+   * Nodes; that loop then runs over a plain array, which the compiler is free to unroll or
+   * vectorize.
+   *
+   * @param[out] buffer             The buffer to fill. Its entries may either be pointers to Nodes,
+   *                                or pointers to the data that the Nodes hold.
+   * @param[in] capacity            The maximum number of entries to write.
+   *
+   * @returns The number of entries written, which is only less than the capacity once the
+   * traversal has ended.
    */
-   inline const Node* operator->() const noexcept
+   template<typename PointerType>
+   std::size_t NextBatch(
+      PointerType* buffer,
+      std::size_t capacity)
    {
-      return m_currentNode;
+      return this->FillBatch(*this, buffer, capacity);
    }
 
    /**
-   * @returns True if the Iterator points to the same node as the other Iterator,
-   * and false otherwise.
+   * @returns An iterator that points past the last Node of the traversal of the specified
+   * Node's subtree. Unlike a default-constructed iterator, it can be decremented.
    */
-   inline bool operator==(const Iterator& other) const
+   static PreOrderIterator End(const Node* node) noexcept
    {
-      return m_currentNode == other.m_currentNode;
+      auto iterator = PreOrderIterator{ };
+      iterator.m_rootNode = node;
+
+      return iterator;
+   }
+};
+
+/**
+* @brief The PostOrderIterator class
+*/
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::PostOrderIterator final
+   : public Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
+{
+public:
+
+   using iterator_category = std::bidirectional_iterator_tag;
+
+   /**
+   * Default constructor.
+   */
+   PostOrderIterator() noexcept = default;
+
+   /**
+   * Constructs an iterator that traverses the subtree rooted at the specified node, starting
+   * with the left-most leaf of that subtree.
+   */
+   explicit PostOrderIterator(const Node* node) noexcept :
+      Iterator{ node }
+   {
+      if (node)
+      {
+         this->m_currentNode = this->FirstDescendant(node);
+      }
    }
 
    /**
-   * @returns True if the Iterator points to the same node as the other Iterator,
-   * and false otherwise.
+   * Prefix increment operator.
    */
-   bool operator!=(const Iterator& other) const noexcept
+   typename Tree::PostOrderIterator& operator++() noexcept
    {
-      return m_currentNode != other.m_currentNode;
+      assert(this->m_currentNode);
+      auto* traversingNode = this->m_currentNode;
+
+      // Every Node is only visited after all of its descendants, so the traversal either moves
+      // on to the first leaf of the next sibling, or back up to the parent:
+      if (traversingNode == this->m_rootNode)
+      {
+         traversingNode = nullptr;
+      }
+      else if (traversingNode->GetNextSibling())
+      {
+         traversingNode = this->FirstDescendant(traversingNode->GetNextSibling());
+      }
+      else
+      {
+         traversingNode = traversingNode->GetParent();
+      }
+
+      this->m_currentNode = traversingNode;
+      return *this;
    }
 
-protected:
+   /**
+   * Postfix increment operator.
+   */
+   typename Tree::PostOrderIterator operator++(int) noexcept
+   {
+      const auto result = *this;
+      ++(*this);
+
+      return result;
+   }
 
    /**
-   * Default constructor.
+   * Prefix decrement operator.
    */
-   Iterator() noexcept = default;
+   typename Tree::PostOrderIterator& operator--() noexcept
+   {
+      auto* traversingNode = this->m_currentNode;
+
+      if (!traversingNode)
+      {
+         assert(this->m_rootNode);
+         traversingNode = const_cast<Node*>(this->m_rootNode);
+      }
+      else if (traversingNode->HasChildren())
+      {
+         traversingNode = traversingNode->GetLastChild();
+      }
+      else
+      {
+         traversingNode = const_cast<Node*>(this->ClimbToPreviousSibling(traversingNode));
+      }
+
+      this->m_currentNode = traversingNode;
+      return *this;
+   }
 
    /**
-   * Copy constructor.
+   * Postfix decrement operator.
    */
-   explicit Iterator(const Iterator& other) noexcept :
-      m_currentNode{ other.m_currentNode },
-      m_startingNode{ other.m_startingNode },
-      m_endingNode{ other.m_endingNode }
+   typename Tree::PostOrderIterator operator--(int) noexcept
    {
+      const auto result = *this;
+      --(*this);
+
+      return result;
    }
 
    /**
-   * Constructs a Iterator started at the specified node.
+   * @copydoc PreOrderIterator::NextBatch
    */
-   explicit Iterator(const Node* node) noexcept :
-      m_currentNode{ const_cast<Node*>(node) },
-      m_startingNode{ const_cast<Node*>(node) }
+   template<typename PointerType>
+   std::size_t NextBatch(
+      PointerType* buffer,
+      std::size_t capacity)
    {
+      return this->FillBatch(*this, buffer, capacity);
    }
 
-   Node* m_currentNode{ nullptr };
+   /**
+   * @returns An iterator that points past the last Node of the traversal of the specified
+   * Node's subtree. Unlike a default-constructed iterator, it can be decremented.
+   */
+   static PostOrderIterator End(const Node* node) noexcept
+   {
+      auto iterator = PostOrderIterator{ };
+      iterator.m_rootNode = node;
 
-   const Node* m_startingNode{ nullptr };
-   const Node* m_endingNode{ nullptr };
+      return iterator;
+   }
 };
 
 /**
-* @brief The PreOrderIterator class
+* @brief The LeafIterator class
 */
-template<typename DataType>
-class Tree<DataType>::PreOrderIterator final : public Tree<DataType>::Iterator
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::LeafIterator final
+   : public Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
 {
 public:
 
+   using iterator_category = std::bidirectional_iterator_tag;
+
    /**
    * Default constructor.
    */
-   PreOrderIterator() noexcept = default;
+   LeafIterator() noexcept = default;
 
    /**
-   * Constructs an iterator that starts and ends at the specified node.
+   * Constructs an iterator that visits every leaf in the subtree rooted at the specified node.
+   *
+   * When the Tree threads its leaves, the iterator simply follows the leaf list, and remembers
+   * the last leaf of the subtree, rather than its root, to know where to stop.
    */
-   explicit PreOrderIterator(const Node* node) noexcept :
+   explicit LeafIterator(const Node* node) noexcept :
       Iterator{ node }
    {
-      if (!node)
+      if (node)
       {
-         return;
+         this->m_currentNode = this->FirstDescendant(node);
+
+         if constexpr (THREADED_LEAVES)
+         {
+            this->m_rootNode = this->LastDescendant(node);
+         }
       }
+   }
+
+   /**
+   * Prefix increment operator.
+   */
+   typename Tree::LeafIterator& operator++() noexcept
+   {
+      assert(this->m_currentNode);
 
-      if (node->GetNextSibling())
+      if constexpr (THREADED_LEAVES)
       {
-         this->m_endingNode = node->GetNextSibling();
+         const auto isLastLeaf = (this->m_currentNode == this->m_rootNode);
+         this->m_currentNode = isLastLeaf ? nullptr : this->m_currentNode->GetNextLeaf();
       }
       else
       {
-         this->m_endingNode = node;
-         while (this->m_endingNode->GetParent() && !this->m_endingNode->GetParent()->GetNextSibling())
-         {
-            this->m_endingNode = this->m_endingNode->GetParent();
-         }
-
-         if (this->m_endingNode->GetParent())
-         {
-            this->m_endingNode = this->m_endingNode->GetParent()->GetNextSibling();
-         }
-         else
-         {
-            this->m_endingNode = nullptr;
-         }
+         const auto* const nextSubtree = this->ClimbToNextSibling(this->m_currentNode);
+         this->m_currentNode = nextSubtree ? this->FirstDescendant(nextSubtree) : nullptr;
       }
+
+      return *this;
    }
 
    /**
-   * Prefix increment operator.
+   * Postfix increment operator.
    */
-   typename Tree::PreOrderIterator& operator++() noexcept
+   typename Tree::LeafIterator operator++(int) noexcept
+   {
+      const auto result = *this;
+      ++(*this);
+
+      return result;
+   }
+
+   /**
+   * Prefix decrement operator.
+   */
+   typename Tree::LeafIterator& operator--() noexcept
    {
-      assert(this->m_currentNode);
       auto* traversingNode = this->m_currentNode;
 
-      if (traversingNode->HasChildren())
+      if constexpr (THREADED_LEAVES)
       {
-         traversingNode = traversingNode->GetFirstChild();
+         assert(this->m_rootNode);
+         traversingNode = traversingNode
+            ? traversingNode->GetPreviousLeaf()
+            : const_cast<Node*>(this->m_rootNode);
+
+         assert(traversingNode);
       }
-      else if (traversingNode->GetNextSibling())
+      else if (!traversingNode)
       {
-         traversingNode = traversingNode->GetNextSibling();
+         assert(this->m_rootNode);
+         traversingNode = this->LastDescendant(this->m_rootNode);
       }
       else
       {
-         while (traversingNode->GetParent() && !traversingNode->GetParent()->GetNextSibling())
-         {
-            traversingNode = traversingNode->GetParent();
-         }
-
-         if (traversingNode->GetParent())
-         {
-            traversingNode = traversingNode->GetParent()->GetNextSibling();
-         }
-         else
-         {
-            traversingNode = nullptr;
-         }
+         traversingNode = this->LastDescendant(this->ClimbToPreviousSibling(traversingNode));
       }
 
-      this->m_currentNode = (traversingNode != this->m_endingNode) ? traversingNode : nullptr;
+      this->m_currentNode = traversingNode;
       return *this;
    }
 
    /**
-   * Postfix increment operator.
+   * Postfix decrement operator.
    */
-   typename Tree::PreOrderIterator operator++(int) noexcept
+   typename Tree::LeafIterator operator--(int) noexcept
    {
       const auto result = *this;
-      ++(*this);
+      --(*this);
 
       return result;
    }
+
+   /**
+   * @copydoc PreOrderIterator::NextBatch
+   */
+   template<typename PointerType>
+   std::size_t NextBatch(
+      PointerType* buffer,
+      std::size_t capacity)
+   {
+      return this->FillBatch(*this, buffer, capacity);
+   }
+
+   /**
+   * @returns An iterator that points past the last Node of the traversal of the specified
+   * Node's subtree. Unlike a default-constructed iterator, it can be decremented.
+   */
+   static LeafIterator End(const Node* node) noexcept
+   {
+      auto iterator = LeafIterator{ };
+      iterator.m_rootNode = (THREADED_LEAVES && node) ? iterator.LastDescendant(node) : node;
+
+      return iterator;
+   }
 };
 
 /**
-* @brief The PostOrderIterator class
+* @brief The LevelOrderIterator class visits the nodes of a subtree breadth-first: first the root of
+* the subtree, then all of its children, then all of its grandchildren, and so on.
+*
+* Only the Nodes on the level being visited are kept, so the memory used is proportional to the
+* width of that level; the next level is gathered from their children once the current level is
+* exhausted. Levels below the maximum depth are never touched. Since copying the iterator copies the
+* current level, it should preferably be advanced in place.
 */
-template<typename DataType>
-class Tree<DataType>::PostOrderIterator final : public Tree<DataType>::Iterator
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::LevelOrderIterator final
+   : public Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
 {
 public:
 
    /**
    * Default constructor.
    */
-   PostOrderIterator() noexcept = default;
+   LevelOrderIterator() noexcept = default;
 
    /**
-   * Constructs an iterator that starts and ends at the specified node.
+   * Constructs an iterator that starts at the specified node, and visits all of its descendants
+   * that are no more than the specified number of levels below it.
    */
-   explicit PostOrderIterator(const Node* node) noexcept :
-      Iterator{ node }
+   explicit LevelOrderIterator(
+      const Node* node,
+      unsigned int maxDepth = std::numeric_limits<unsigned int>::max())
+      :
+      Iterator{ node },
+      m_maxDepth{ maxDepth }
    {
-      if (!node)
+      if (node)
       {
-         return;
+         m_level.emplace_back(const_cast<Node*>(node));
       }
+   }
 
-      // Compute and set the starting node:
+   /**
+   * Prefix increment operator.
+   */
+   typename Tree::LevelOrderIterator& operator++()
+   {
+      assert(this->m_currentNode);
 
-      auto* traversingNode = node;
-      while (traversingNode->GetFirstChild())
+      if (++m_index == m_level.size())
       {
-         traversingNode = traversingNode->GetFirstChild();
+         DescendOneLevel();
       }
 
-      assert(traversingNode);
-      this->m_currentNode = const_cast<Node*>(traversingNode);
-
-      // Commpute and set the ending node:
+      this->m_currentNode = (m_index < m_level.size()) ? m_level[m_index] : nullptr;
+      return *this;
+   }
 
-      if (node->GetNextSibling())
-      {
-         traversingNode = node->GetNextSibling();
-         while (traversingNode->HasChildren())
-         {
-            traversingNode = traversingNode->GetFirstChild();
-         }
+   /**
+   * Postfix increment operator.
+   */
+   typename Tree::LevelOrderIterator operator++(int)
+   {
+      const auto result = *this;
+      ++(*this);
 
-         this->m_endingNode = traversingNode;
-      }
-      else
-      {
-         this->m_endingNode = node->GetParent();
-      }
+      return result;
    }
 
    /**
-   * Prefix increment operator.
+   * @returns The depth of the current Node, relative to the Node that the iteration started at.
    */
-   typename Tree::PostOrderIterator& operator++() noexcept
+   unsigned int GetDepth() const noexcept
    {
-      assert(this->m_currentNode);
-      auto* traversingNode = this->m_currentNode;
+      return m_depth;
+   }
 
-      if (traversingNode->HasChildren() && !m_traversingUpTheTree)
+   /**
+   * @copydoc PreOrderIterator::NextBatch
+   *
+   * Since the current level is already gathered into an array, the entries are copied from there
+   * one run at a time.
+   */
+   template<typename PointerType>
+   std::size_t NextBatch(
+      PointerType* buffer,
+      std::size_t capacity)
+   {
+      std::size_t count{ 0 };
+      while (count < capacity && this->m_currentNode)
       {
-         while (traversingNode->GetFirstChild())
+         const auto length = std::min(capacity - count, m_level.size() - m_index);
+         for (std::size_t offset{ 0 }; offset < length; ++offset)
          {
-            traversingNode = traversingNode->GetFirstChild();
+            buffer[count + offset] =
+               this->template ToBatchEntry<PointerType>(m_level[m_index + offset]);
          }
+
+         count += length;
+
+         // Step onto the last Node that was copied, and then past it, so that the next level is
+         // gathered when needed:
+         m_index += length - 1;
+         ++(*this);
       }
-      else if (traversingNode->GetNextSibling())
-      {
-         m_traversingUpTheTree = false;
 
-         traversingNode = traversingNode->GetNextSibling();
-         while (traversingNode->HasChildren())
+      return count;
+   }
+
+private:
+
+   void DescendOneLevel()
+   {
+      std::vector<Node*> nextLevel;
+
+      if (m_depth < m_maxDepth)
+      {
+         for (const auto* node : m_level)
          {
-            traversingNode = traversingNode->GetFirstChild();
+            for (auto* child = node->GetFirstChild(); child; child = child->GetNextSibling())
+            {
+               nextLevel.emplace_back(child);
+            }
          }
       }
-      else
-      {
-         m_traversingUpTheTree = true;
 
-         traversingNode = traversingNode->GetParent();
-      }
+      m_level.swap(nextLevel);
+      m_index = 0;
+      ++m_depth;
+   }
+
+   std::vector<Node*> m_level;
+   std::size_t m_index{ 0 };
+
+   unsigned int m_depth{ 0 };
+   unsigned int m_maxDepth{ std::numeric_limits<unsigned int>::max() };
+};
+
+/**
+* @brief The PrefetchingIterator class wraps a pre- or post-order iterator, and prefetches the Nodes
+* that could be visited soon.
+*
+* Whenever the iterator arrives at a Node, the links of that Node already sit in the cache, so the
+* Nodes that may follow it can be prefetched without any additional dependent loads: in pre-order,
+* these are the first child, the next sibling, and the next sibling of the parent; in post-order,
+* the next sibling and the parent. The data of each candidate is prefetched alongside it.
+*
+* To look further ahead, the prefetched candidates are also queued up in a small ring that holds
+* up to the prefetch distance worth of Nodes. On every step, the oldest Node in that ring, whose
+* prefetch was issued a few steps earlier and has hopefully completed by now, has its own first
+* child and next sibling prefetched and queued up in turn. Unlike a second iterator running ahead,
+* which would have to chase the very same chain of pointers and stall on the same misses, the ring
+* never reads a Node that was only just requested, so several misses can be in flight at once.
+* Once the ring is full, the oldest Nodes make way for the candidates around the current Node. A
+* distance of zero disables prefetching altogether.
+*/
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+template<typename IteratorType>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::PrefetchingIterator final
+{
+public:
+
+   using value_type = typename IteratorType::value_type;
+   using pointer = typename IteratorType::pointer;
+   using reference = typename IteratorType::reference;
+   using const_reference = typename IteratorType::const_reference;
+   using size_type = typename IteratorType::size_type;
+   using difference_type = typename IteratorType::difference_type;
+   using iterator_category = std::forward_iterator_tag;
+
+   /**
+   * Default constructor.
+   */
+   PrefetchingIterator() noexcept = default;
+
+   /**
+   * @param[in] iterator            The iterator that determines which Nodes are visited.
+   * @param[in] distance            The number of prefetched Nodes to keep queued up, which is
+   *                                clamped to MAX_PREFETCH_DISTANCE.
+   */
+   PrefetchingIterator(
+      IteratorType iterator,
+      std::size_t distance) noexcept
+      :
+      m_iterator{ iterator },
+      m_distance{ std::min(distance, MAX_PREFETCH_DISTANCE) }
+   {
+      PrefetchAhead();
+   }
+
+   /**
+   * @returns True if the iterator points to a valid Node; false otherwise.
+   */
+   explicit operator bool() const noexcept
+   {
+      return static_cast<bool>(m_iterator);
+   }
+
+   /**
+   * @returns The Node pointed to by the iterator.
+   */
+   inline Node& operator*() const noexcept
+   {
+      return *m_iterator;
+   }
+
+   /**
+   * @returns A pointer to the Node pointed to by the iterator.
+   */
+   inline Node* operator->() const noexcept
+   {
+      return m_iterator.operator->();
+   }
+
+   /**
+   * Prefix increment operator.
+   */
+   PrefetchingIterator& operator++() noexcept
+   {
+      ++m_iterator;
+      PrefetchAhead();
 
-      this->m_currentNode = (traversingNode != this->m_endingNode) ? traversingNode : nullptr;
       return *this;
    }
 
    /**
    * Postfix increment operator.
    */
-   typename Tree::PostOrderIterator operator++(int) noexcept
+   PrefetchingIterator operator++(int) noexcept
    {
       const auto result = *this;
       ++(*this);
@@ -1221,150 +5036,104 @@ public:
       return result;
    }
 
-private:
-
-   bool m_traversingUpTheTree{ false };
-};
-
-/**
-* @brief The LeafIterator class
-*/
-template<typename DataType>
-class Tree<DataType>::LeafIterator final : public Tree<DataType>::Iterator
-{
-public:
-
    /**
-   * Default constructor.
+   * @returns True if both iterators point to the same Node, and false otherwise.
    */
-   LeafIterator() noexcept = default;
+   bool operator==(const PrefetchingIterator& other) const noexcept
+   {
+      return m_iterator == other.m_iterator;
+   }
 
    /**
-   * Constructs an iterator that starts at the specified node and iterates to the end.
+   * @returns True if the iterators point to different Nodes, and false otherwise.
    */
-   explicit LeafIterator(const Node* node) noexcept :
-      Iterator{ node }
+   bool operator!=(const PrefetchingIterator& other) const noexcept
    {
-      if (!node)
+      return m_iterator != other.m_iterator;
+   }
+
+private:
+
+   void PrefetchAhead() noexcept
+   {
+      if (!m_iterator || m_distance == 0)
       {
          return;
       }
 
-      // Compute and set the starting node:
-
-      if (node->HasChildren())
+      // The oldest queued Node is expanded first, so that its prefetch has had the most time:
+      if (m_pendingCount > 0)
       {
-         auto* firstNode = node;
-         while (firstNode->GetFirstChild())
-         {
-            firstNode = firstNode->GetFirstChild();
-         }
+         const auto* const pending = m_pending[m_firstPending];
+         m_firstPending = (m_firstPending + 1) % m_distance;
+         --m_pendingCount;
 
-         this->m_currentNode = const_cast<Node*>(firstNode);
+         Enqueue(pending->GetNextSibling());
+         Enqueue(pending->GetFirstChild());
       }
 
-      // Compute and set the ending node:
+      // The Node that is most likely to be visited next goes in last, so that it stays the longest:
+      const auto& node = *m_iterator;
 
-      if (node->GetNextSibling())
+      if constexpr (std::is_same_v<IteratorType, PreOrderIterator>)
       {
-         auto* lastNode = node->GetNextSibling();
-         while (lastNode->HasChildren())
+         // The parent was visited on the way down, so its links are likely still cached:
+         if (const auto* const parent = node.GetParent())
          {
-            lastNode = lastNode->GetFirstChild();
+            Enqueue(parent->GetNextSibling());
          }
 
-         this->m_endingNode = lastNode;
+         Enqueue(node.GetNextSibling());
+         Enqueue(node.GetFirstChild());
       }
       else
       {
-         this->m_endingNode = node;
-         while (this->m_endingNode->GetParent() && !this->m_endingNode->GetParent()->GetNextSibling())
-         {
-            this->m_endingNode = this->m_endingNode->GetParent();
-         }
-
-         if (this->m_endingNode->GetParent())
-         {
-            this->m_endingNode = this->m_endingNode->GetParent()->GetNextSibling();
-            while (this->m_endingNode->HasChildren())
-            {
-               this->m_endingNode = this->m_endingNode->GetFirstChild();
-            }
-         }
-         else
-         {
-            this->m_endingNode = nullptr;
-         }
+         Enqueue(node.GetParent());
+         Enqueue(node.GetNextSibling());
       }
    }
 
-   /**
-   * Prefix increment operator.
-   */
-   typename Tree::LeafIterator& operator++() noexcept
+   void Enqueue(const Node* node) noexcept
    {
-      assert(this->m_currentNode);
-      auto* traversingNode = this->m_currentNode;
-
-      if (traversingNode->HasChildren())
+      if (!node)
       {
-         while (traversingNode->GetFirstChild())
-         {
-            traversingNode = traversingNode->GetFirstChild();
-         }
+         return;
       }
-      else if (traversingNode->GetNextSibling())
-      {
-         traversingNode = traversingNode->GetNextSibling();
 
-         while (traversingNode->GetFirstChild())
-         {
-            traversingNode = traversingNode->GetFirstChild();
-         }
-      }
-      else if (traversingNode->GetParent())
-      {
-         while (traversingNode->GetParent() && !traversingNode->GetParent()->GetNextSibling())
-         {
-            traversingNode = traversingNode->GetParent();
-         }
+      TreeInternals::Prefetch(node);
+      TreeInternals::Prefetch(std::addressof(node->GetData()));
 
-         if (traversingNode->GetParent())
-         {
-            traversingNode = traversingNode->GetParent()->GetNextSibling();
+      if (m_pendingCount < m_distance)
+      {
+         m_pending[(m_firstPending + m_pendingCount) % m_distance] = node;
+         ++m_pendingCount;
 
-            while (traversingNode && traversingNode->HasChildren())
-            {
-               traversingNode = traversingNode->GetFirstChild();
-            }
-         }
-         else
-         {
-            traversingNode = nullptr;
-         }
+         return;
       }
 
-      this->m_currentNode = (traversingNode != this->m_endingNode) ? traversingNode : nullptr;
-      return *this;
+      // The ring is full, so the oldest Node makes way:
+      m_pending[m_firstPending] = node;
+      m_firstPending = (m_firstPending + 1) % m_distance;
    }
 
-   /**
-   * Postfix increment operator.
-   */
-   typename Tree::LeafIterator operator++(int) noexcept
-   {
-      const auto result = *this;
-      ++(*this);
+   IteratorType m_iterator;
 
-      return result;
-   }
+   std::array<const Node*, MAX_PREFETCH_DISTANCE> m_pending{ };
+   std::size_t m_firstPending{ 0 };
+   std::size_t m_pendingCount{ 0 };
+   std::size_t m_distance{ 0 };
 };
 
 /**
 * @brief The SiblingIterator class
 */
-template<typename DataType>
-class Tree<DataType>::SiblingIterator final : public Tree<DataType>::Iterator
+template<
+   typename DataType,
+   typename AggregatePolicy,
+   bool ThreadedLeaves
+>
+class Tree<DataType, AggregatePolicy, ThreadedLeaves>::SiblingIterator final
+   : public Tree<DataType, AggregatePolicy, ThreadedLeaves>::Iterator
 {
 public:
 
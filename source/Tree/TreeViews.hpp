@@ -0,0 +1,394 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "Tree.hpp"
+
+#if defined(__cpp_lib_ranges)
+
+#include <iterator>
+#include <ranges>
+
+/**
+* @brief Tree-aware range adaptors, to be composed with the views that Tree::PreOrder and
+* Tree::Subtree return, with each other, and with the standard range adaptors:
+*
+*    tree.PreOrder() | TreeViews::FilterSubtrees(isVisible) | TreeViews::Take(100)
+*
+* Unlike the standard adaptors, these don't merely skip over Nodes, but over entire subtrees, so
+* that the pruned parts of a Tree are never visited at all. Everything is evaluated lazily, one
+* Node at a time, as the resulting view is iterated over.
+*/
+namespace TreeViews
+{
+   /**
+   * @brief Satisfied by pre-order traversals whose iterators can skip over the descendants of the
+   * current Node.
+   */
+   template<typename ViewType>
+   concept SkippableTraversal = std::ranges::view<ViewType>
+      && std::ranges::forward_range<const ViewType>
+      && requires (std::ranges::iterator_t<const ViewType> itr) { itr.SkipDescendants(); };
+
+   /**
+   * @brief A view over the Nodes of a pre-order traversal that are no deeper than a given depth,
+   * relative to the first Node of the traversal. Anything deeper is skipped without being visited.
+   */
+   template<SkippableTraversal ViewType>
+   class DepthLimitedView : public std::ranges::view_interface<DepthLimitedView<ViewType>>
+   {
+      using BaseIterator = std::ranges::iterator_t<const ViewType>;
+      using BaseSentinel = std::ranges::sentinel_t<const ViewType>;
+
+   public:
+
+      class Iterator
+      {
+      public:
+
+         using value_type = std::iter_value_t<BaseIterator>;
+         using difference_type = std::iter_difference_t<BaseIterator>;
+         using iterator_concept = std::forward_iterator_tag;
+         using iterator_category = std::forward_iterator_tag;
+
+         Iterator() = default;
+
+         Iterator(
+            BaseIterator base,
+            BaseSentinel end,
+            unsigned int maxDepth)
+            :
+            m_base{ std::move(base) },
+            m_end{ std::move(end) },
+            m_maxDepth{ maxDepth }
+         {
+         }
+
+         decltype(auto) operator*() const
+         {
+            return *m_base;
+         }
+
+         auto operator->() const
+         {
+            return std::addressof(*m_base);
+         }
+
+         Iterator& operator++()
+         {
+            return Advance(m_depth == m_maxDepth);
+         }
+
+         Iterator operator++(int)
+         {
+            auto result = *this;
+            ++*this;
+
+            return result;
+         }
+
+         /**
+         * @brief Advances the iterator to the next Node that isn't a descendant of the current one.
+         */
+         Iterator& SkipDescendants()
+         {
+            return Advance(true);
+         }
+
+         /**
+         * @returns The depth of the current Node, relative to the first Node of the traversal.
+         */
+         unsigned int GetDepth() const noexcept
+         {
+            return m_depth;
+         }
+
+         friend bool operator==(
+            const Iterator& lhs,
+            const Iterator& rhs)
+         {
+            return lhs.m_base == rhs.m_base;
+         }
+
+         friend bool operator==(
+            const Iterator& itr,
+            const BaseSentinel& end)
+         {
+            return itr.m_base == end;
+         }
+
+      private:
+
+         Iterator& Advance(bool skipDescendants)
+         {
+            const auto* const previous = std::addressof(*m_base);
+
+            if (skipDescendants)
+            {
+               m_base.SkipDescendants();
+            }
+            else
+            {
+               ++m_base;
+            }
+
+            if (m_base == m_end)
+            {
+               return *this;
+            }
+
+            // In pre-order, the next Node is always a child of the previous Node, or of one of its
+            // ancestors, so the depth can be found by climbing up to that parent:
+            const auto* const parent = (*m_base).GetParent();
+            for (const auto* node = previous; node != parent; node = node->GetParent())
+            {
+               --m_depth;
+            }
+
+            ++m_depth;
+            return *this;
+         }
+
+         BaseIterator m_base{ };
+         BaseSentinel m_end{ };
+
+         unsigned int m_depth{ 0 };
+         unsigned int m_maxDepth{ 0 };
+      };
+
+      DepthLimitedView() = default;
+
+      DepthLimitedView(
+         ViewType base,
+         unsigned int maxDepth)
+         :
+         m_base{ std::move(base) },
+         m_maxDepth{ maxDepth }
+      {
+      }
+
+      Iterator begin() const
+      {
+         return Iterator{ std::ranges::begin(m_base), std::ranges::end(m_base), m_maxDepth };
+      }
+
+      BaseSentinel end() const
+      {
+         return std::ranges::end(m_base);
+      }
+
+   private:
+
+      ViewType m_base{ };
+      unsigned int m_maxDepth{ 0 };
+   };
+
+   /**
+   * @brief A view over the Nodes of a pre-order traversal that satisfy a predicate. When a Node
+   * is rejected, so is its entire subtree, without the predicate ever being invoked on any of its
+   * descendants.
+   */
+   template<
+      SkippableTraversal ViewType,
+      typename PredicateType
+   >
+   class FilterSubtreesView
+      : public std::ranges::view_interface<FilterSubtreesView<ViewType, PredicateType>>
+   {
+      using BaseIterator = std::ranges::iterator_t<const ViewType>;
+      using BaseSentinel = std::ranges::sentinel_t<const ViewType>;
+
+   public:
+
+      class Iterator
+      {
+      public:
+
+         using value_type = std::iter_value_t<BaseIterator>;
+         using difference_type = std::iter_difference_t<BaseIterator>;
+         using iterator_concept = std::forward_iterator_tag;
+         using iterator_category = std::forward_iterator_tag;
+
+         Iterator() = default;
+
+         Iterator(
+            BaseIterator base,
+            BaseSentinel end,
+            const PredicateType* predicate)
+            :
+            m_base{ std::move(base) },
+            m_end{ std::move(end) },
+            m_predicate{ predicate }
+         {
+            SkipRejectedSubtrees();
+         }
+
+         decltype(auto) operator*() const
+         {
+            return *m_base;
+         }
+
+         auto operator->() const
+         {
+            return std::addressof(*m_base);
+         }
+
+         Iterator& operator++()
+         {
+            ++m_base;
+            SkipRejectedSubtrees();
+
+            return *this;
+         }
+
+         Iterator operator++(int)
+         {
+            auto result = *this;
+            ++*this;
+
+            return result;
+         }
+
+         /**
+         * @brief Advances the iterator to the next accepted Node that isn't a descendant of the
+         * current one.
+         */
+         Iterator& SkipDescendants()
+         {
+            m_base.SkipDescendants();
+            SkipRejectedSubtrees();
+
+            return *this;
+         }
+
+         friend bool operator==(
+            const Iterator& lhs,
+            const Iterator& rhs)
+         {
+            return lhs.m_base == rhs.m_base;
+         }
+
+         friend bool operator==(
+            const Iterator& itr,
+            const BaseSentinel& end)
+         {
+            return itr.m_base == end;
+         }
+
+      private:
+
+         void SkipRejectedSubtrees()
+         {
+            while (m_base != m_end && !(*m_predicate)(std::as_const(*m_base)))
+            {
+               m_base.SkipDescendants();
+            }
+         }
+
+         BaseIterator m_base{ };
+         BaseSentinel m_end{ };
+
+         const PredicateType* m_predicate{ nullptr };
+      };
+
+      FilterSubtreesView() = default;
+
+      FilterSubtreesView(
+         ViewType base,
+         PredicateType predicate)
+         :
+         m_base{ std::move(base) },
+         m_predicate{ std::make_shared<const PredicateType>(std::move(predicate)) }
+      {
+      }
+
+      Iterator begin() const
+      {
+         return Iterator{ std::ranges::begin(m_base), std::ranges::end(m_base), m_predicate.get() };
+      }
+
+      BaseSentinel end() const
+      {
+         return std::ranges::end(m_base);
+      }
+
+   private:
+
+      ViewType m_base{ };
+
+      // Lambdas can't be assigned to, but views have to be; sharing the predicate also keeps it
+      // at the same address, so that iterators remain valid when the view is moved:
+      std::shared_ptr<const PredicateType> m_predicate;
+   };
+
+   /**
+   * @brief The range adaptor closure returned by DepthLimited.
+   */
+   struct DepthLimitedAdaptor
+   {
+      template<std::ranges::viewable_range RangeType>
+      friend auto operator|(
+         RangeType&& range,
+         const DepthLimitedAdaptor& adaptor)
+      {
+         using BaseView = std::views::all_t<RangeType>;
+         return DepthLimitedView<BaseView>{
+            std::views::all(std::forward<RangeType>(range)), adaptor.maxDepth };
+      }
+
+      unsigned int maxDepth;
+   };
+
+   /**
+   * @brief The range adaptor closure returned by FilterSubtrees.
+   */
+   template<typename PredicateType>
+   struct FilterSubtreesAdaptor
+   {
+      template<std::ranges::viewable_range RangeType>
+      friend auto operator|(
+         RangeType&& range,
+         FilterSubtreesAdaptor adaptor)
+      {
+         using BaseView = std::views::all_t<RangeType>;
+         return FilterSubtreesView<BaseView, PredicateType>{
+            std::views::all(std::forward<RangeType>(range)), std::move(adaptor.predicate) };
+      }
+
+      PredicateType predicate;
+   };
+
+   /**
+   * @param[in] maxDepth            The depth of the deepest Nodes to keep, where the first Node of
+   *                                the traversal has a depth of zero.
+   *
+   * @returns An adaptor that limits a pre-order traversal to the specified depth.
+   */
+   inline DepthLimitedAdaptor DepthLimited(unsigned int maxDepth) noexcept
+   {
+      return DepthLimitedAdaptor{ maxDepth };
+   }
+
+   /**
+   * @param[in] predicate           A callable type that is copied into the view. This type should
+   *                                be equivalent to:
+   *                                   bool predicate(const Node& node);
+   *
+   * @returns An adaptor that drops every Node from a pre-order traversal that doesn't satisfy the
+   * predicate, along with its entire subtree.
+   */
+   template<typename PredicateType>
+   FilterSubtreesAdaptor<PredicateType> FilterSubtrees(PredicateType predicate)
+   {
+      return FilterSubtreesAdaptor<PredicateType>{ std::move(predicate) };
+   }
+
+   /**
+   * @brief Stops any traversal after the specified number of Nodes; an alias of the standard
+   * std::views::take, so that complete pipelines can be spelled in terms of this namespace.
+   */
+   inline constexpr auto Take = std::views::take;
+}
+
+#endif
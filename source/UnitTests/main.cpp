@@ -3,9 +3,26 @@
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "Catch.hpp"
 
+#include "../Benchmarks/HyperLogLog.h"
+#include "../Benchmarks/QuantileSketch.h"
+#include "../Benchmarks/Utf8.hpp"
+#include "../Tree/LevelIndex.hpp"
+#include "../Tree/PreOrderColumn.hpp"
 #include "../Tree/Tree.hpp"
+#include "../Tree/TreeViews.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace
@@ -211,6 +228,45 @@ TEST_CASE("Prepending and Appending Nodes")
    }
 }
 
+TEST_CASE("Splicing Children")
+{
+   Tree<int> tree{ 0 };
+   tree.GetRoot()->AppendChild(1);
+   tree.GetRoot()->AppendChild(2);
+
+   Tree<int>::Node donor{ -1 };
+   donor.AppendChild(3)->AppendChild(4);
+   donor.AppendChild(5);
+
+   tree.GetRoot()->SpliceChildren(donor);
+
+   REQUIRE(donor.HasChildren() == false);
+   REQUIRE(donor.GetFirstChild() == nullptr);
+   REQUIRE(donor.GetLastChild() == nullptr);
+
+   REQUIRE(tree.GetRoot()->GetChildCount() == 4);
+   REQUIRE(tree.GetRoot()->GetLastChild()->GetData() == 5);
+   REQUIRE(tree.GetRoot()->GetLastChild()->GetPreviousSibling()->GetData() == 3);
+
+   const auto allChildrenReparented = std::all_of(
+      Tree<int>::SiblingIterator{ tree.GetRoot()->GetFirstChild() },
+      Tree<int>::SiblingIterator{ },
+      [&] (Tree<int>::const_reference node) noexcept
+   {
+      return node.GetParent() == tree.GetRoot();
+   });
+
+   REQUIRE(allChildrenReparented);
+
+   const std::vector<int> expected = { 0, 1, 2, 3, 4, 5 };
+
+   std::vector<int> actual;
+   std::transform(tree.beginPreOrder(), tree.endPreOrder(), std::back_inserter(actual),
+      [] (const auto& node) noexcept { return node.GetData(); });
+
+   VerifyTraversal(expected, actual);
+}
+
 TEST_CASE("Node Counting")
 {
    Tree<std::string> tree{ "F" };
@@ -321,7 +377,7 @@ TEST_CASE("Forward Pre- and Post-Order Traversal of Simple Binary Tree")
    }
 }
 
-TEST_CASE("Partial Tree Iteration")
+TEST_CASE("Reverse Traversal of Simple Binary Tree")
 {
    Tree<std::string> tree{ "F" };
 
@@ -330,36 +386,76 @@ TEST_CASE("Partial Tree Iteration")
    tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
    tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
 
-   SECTION("Pre-Order Iteration")
+   SECTION("Reverse Pre-order Traversal")
    {
-      const std::vector<std::string> expected = { "B", "A", "D", "C", "E" };
+      const std::vector<std::string> expected = { "H", "I", "G", "E", "C", "D", "A", "B", "F" };
 
-      const auto begin = decltype(tree)::PreOrderIterator{ tree.GetRoot()->GetFirstChild() };
-      const auto end = decltype(tree)::PreOrderIterator{ };
+      std::vector<std::string> actual;
+      std::transform(tree.rbeginPreOrder(), tree.rendPreOrder(), std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Reverse Post-order Traversal")
+   {
+      const std::vector<std::string> expected = { "F", "G", "I", "H", "B", "D", "E", "C", "A" };
 
       std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
+      std::transform(tree.rbegin(), tree.rend(), std::back_inserter(actual),
          [] (const auto& node) noexcept { return node.GetData(); });
 
       VerifyTraversal(expected, actual);
    }
 
-   SECTION("Post-Order Iteration")
+   SECTION("Reverse Leaf Traversal")
    {
-      const std::vector<std::string> expected = { "A", "C", "E", "D", "B" };
+      const std::vector<std::string> expected = { "H", "E", "C", "A" };
 
-      const auto begin = decltype(tree)::PostOrderIterator{ tree.GetRoot()->GetFirstChild() };
-      const auto end = decltype(tree)::PostOrderIterator{ };
+      std::vector<std::string> actual;
+      std::transform(tree.rbeginLeaf(), tree.rendLeaf(), std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Reverse Traversal of a Subtree")
+   {
+      const auto* const subtree = tree.GetRoot()->GetFirstChild();
+
+      const std::vector<std::string> expected = { "E", "C", "D", "A", "B" };
 
       std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
+      std::transform(
+         std::make_reverse_iterator(Tree<std::string>::PreOrderIterator::End(subtree)),
+         std::make_reverse_iterator(Tree<std::string>::PreOrderIterator{ subtree }),
+         std::back_inserter(actual),
          [] (const auto& node) noexcept { return node.GetData(); });
 
       VerifyTraversal(expected, actual);
    }
+
+   SECTION("Stepping Back and Forth")
+   {
+      auto itr = std::prev(std::end(tree));
+      REQUIRE(itr->GetData() == "F");
+
+      --itr;
+      REQUIRE(itr->GetData() == "G");
+
+      ++itr;
+      ++itr;
+      REQUIRE(itr == std::end(tree));
+
+      auto leaf = std::prev(tree.endLeaf(), 2);
+      REQUIRE(leaf->GetData() == "E");
+
+      ++leaf;
+      REQUIRE(leaf->GetData() == "H");
+   }
 }
 
-TEST_CASE("Partial Tree Iteration Corner Cases")
+TEST_CASE("Sentinel-Terminated Traversal")
 {
    Tree<std::string> tree{ "F" };
 
@@ -368,56 +464,211 @@ TEST_CASE("Partial Tree Iteration Corner Cases")
    tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
    tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
 
-   SECTION("Pre-Order Iteration")
+   using TreeType = decltype(tree);
+
+   SECTION("Iterators Only Carry the Current Node and the Root of the Traversal")
    {
-      const std::vector<std::string> expected = { "D", "C", "E" };
+      REQUIRE(sizeof(TreeType::PreOrderIterator) == 2 * sizeof(TreeType::Node*));
+      REQUIRE(sizeof(TreeType::PostOrderIterator) == 2 * sizeof(TreeType::Node*));
+      REQUIRE(sizeof(TreeType::LeafIterator) == 2 * sizeof(TreeType::Node*));
+   }
 
-      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+   SECTION("Pre-Order Traversal of a Subtree")
+   {
+      const std::vector<std::string> expected = { "B", "A", "D", "C", "E" };
 
-      const auto begin = decltype(tree)::PreOrderIterator{ startingNode };
-      const auto end = decltype(tree)::PreOrderIterator{ };
+      std::vector<std::string> actual;
+      auto itr = TreeType::PreOrderIterator{ tree.GetRoot()->GetFirstChild() };
+      for (; itr != TreeType::Sentinel{ }; ++itr)
+      {
+         actual.emplace_back(itr->GetData());
+      }
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Post-Order Traversal of a Subtree")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "D", "B" };
 
       std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+      auto itr = TreeType::PostOrderIterator{ tree.GetRoot()->GetFirstChild() };
+      for (; itr != TreeType::Sentinel{ }; ++itr)
+      {
+         actual.emplace_back(itr->GetData());
+      }
 
       VerifyTraversal(expected, actual);
    }
 
-   SECTION("Post-Order Iteration")
+   SECTION("Leaf Traversal of a Subtree")
    {
-      const std::vector<std::string> expected = { "C", "E", "D" };
+      const std::vector<std::string> expected = { "H" };
 
-      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+      std::vector<std::string> actual;
+      auto itr = TreeType::LeafIterator{ tree.GetRoot()->GetLastChild() };
+      for (; TreeType::Sentinel{ } != itr; ++itr)
+      {
+         actual.emplace_back(itr->GetData());
+      }
 
-      const auto begin = decltype(tree)::PostOrderIterator{ startingNode };
-      const auto end = decltype(tree)::PostOrderIterator{ };
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("End Iterators Compare Equal to the Sentinel")
+   {
+      REQUIRE(tree.endPreOrder() == TreeType::Sentinel{ });
+      REQUIRE(tree.end() == TreeType::Sentinel{ });
+      REQUIRE(TreeType::Sentinel{ } == tree.endLeaf());
+      REQUIRE(tree.begin() != TreeType::Sentinel{ });
+   }
+}
+
+TEST_CASE("Prefetching Traversal")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   const auto toData = [] (const auto& node) { return node.GetData(); };
+
+   SECTION("Pre-Order Traversal Is Unaffected by the Prefetch Distance")
+   {
+      const std::vector<std::string> expected = { "F", "B", "A", "D", "C", "E", "G", "I", "H" };
+
+      for (const std::size_t distance : { 0u, 1u, 4u, 100u })
+      {
+         std::vector<std::string> actual;
+         std::transform(tree.beginPreOrderPrefetched(distance), tree.endPreOrderPrefetched(),
+            std::back_inserter(actual), toData);
+
+         VerifyTraversal(expected, actual);
+      }
+   }
+
+   SECTION("Post-Order Traversal Is Unaffected by the Prefetch Distance")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "D", "B", "H", "I", "G", "F" };
+
+      for (const std::size_t distance : { 0u, 1u, 4u, 100u })
+      {
+         std::vector<std::string> actual;
+         std::transform(tree.beginPrefetched(distance), tree.endPrefetched(),
+            std::back_inserter(actual), toData);
+
+         VerifyTraversal(expected, actual);
+      }
+   }
+}
+
+TEST_CASE("Internal Traversal")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   using TreeType = decltype(tree);
+
+   SECTION("Pre-Order Traversal")
+   {
+      const std::vector<std::string> expected = { "F", "B", "A", "D", "C", "E", "G", "I", "H" };
 
       std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+      const auto completed = TreeType::Traverse<TraversalOrder::PRE_ORDER>(*tree.GetRoot(),
+         [&] (const TreeType::Node& node)
+      {
+         actual.emplace_back(node.GetData());
+         return VisitResult::CONTINUE;
+      });
 
+      REQUIRE(completed);
       VerifyTraversal(expected, actual);
    }
 
-   SECTION("Leaf Iteration")
+   SECTION("Post-Order Traversal")
    {
-      const std::vector<std::string> expected = { "C", "E" };
+      const std::vector<std::string> expected = { "A", "C", "E", "D", "B", "H", "I", "G", "F" };
 
-      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+      std::vector<std::string> actual;
+      const auto completed = TreeType::Traverse<TraversalOrder::POST_ORDER>(*tree.GetRoot(),
+         [&] (const TreeType::Node& node)
+      {
+         actual.emplace_back(node.GetData());
+         return VisitResult::CONTINUE;
+      });
 
-      const auto begin = decltype(tree)::LeafIterator{ startingNode };
-      const auto end = decltype(tree)::LeafIterator{ };
+      REQUIRE(completed);
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Skipping the Children of a Node")
+   {
+      const std::vector<std::string> expected = { "F", "B", "A", "D", "G", "I", "H" };
 
       std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+      TreeType::Traverse<TraversalOrder::PRE_ORDER>(*tree.GetRoot(),
+         [&] (const TreeType::Node& node)
+      {
+         actual.emplace_back(node.GetData());
+         return node.GetData() == "D" ? VisitResult::SKIP_CHILDREN : VisitResult::CONTINUE;
+      });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Stopping Early")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "D" };
+
+      std::vector<std::string> actual;
+      const auto completed = TreeType::Traverse<TraversalOrder::POST_ORDER>(*tree.GetRoot(),
+         [&] (const TreeType::Node& node)
+      {
+         actual.emplace_back(node.GetData());
+         return node.GetData() == "D" ? VisitResult::STOP : VisitResult::CONTINUE;
+      });
+
+      REQUIRE(!completed);
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Traversing a Subtree")
+   {
+      const std::vector<std::string> expected = { "B", "A", "D", "C", "E" };
+
+      const TreeType::Node& subtree = *tree.GetRoot()->GetFirstChild();
+
+      std::vector<std::string> actual;
+      TreeType::Traverse<TraversalOrder::PRE_ORDER>(subtree,
+         [&] (const TreeType::Node& node)
+      {
+         actual.emplace_back(node.GetData());
+         return VisitResult::CONTINUE;
+      });
 
       VerifyTraversal(expected, actual);
    }
+
+   SECTION("Modifying Data")
+   {
+      TreeType::Traverse<TraversalOrder::PRE_ORDER>(*tree.GetRoot(), [] (TreeType::Node& node)
+      {
+         node.GetData() += node.GetData();
+         return VisitResult::CONTINUE;
+      });
+
+      REQUIRE(tree.GetRoot()->GetData() == "FF");
+      REQUIRE(tree.GetRoot()->GetLastChild()->GetFirstChild()->GetData() == "II");
+   }
 }
 
-TEST_CASE("STL Typedef Compliance")
+TEST_CASE("Depth-First Walk")
 {
    Tree<std::string> tree{ "F" };
 
@@ -426,180 +677,1758 @@ TEST_CASE("STL Typedef Compliance")
    tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
    tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
 
-   SECTION("Standard Algorithms and Parameter Passing by value_type")
+   using TreeType = decltype(tree);
+
+   struct EventRecorder
    {
-      const auto count = std::count_if(std::begin(tree), std::end(tree),
-         [] (Tree<std::string>::value_type node) noexcept
+      void OnEnter(const TreeType::Node& node, unsigned int depth)
       {
-         return (node.GetData() == "A");
-      });
+         events.emplace_back("+" + node.GetData() + std::to_string(depth));
+      }
 
-      REQUIRE(count == 1);
+      void OnExit(const TreeType::Node& node, unsigned int depth)
+      {
+         events.emplace_back("-" + node.GetData() + std::to_string(depth));
+      }
+
+      std::vector<std::string> events;
+   };
+
+   SECTION("Entering and Exiting Every Node")
+   {
+      const std::vector<std::string> expected =
+      {
+         "+F0", "+B1", "+A2", "-A2", "+D2", "+C3", "-C3", "+E3", "-E3", "-D2", "-B1",
+         "+G1", "+I2", "+H3", "-H3", "-I2", "-G1", "-F0"
+      };
+
+      EventRecorder recorder;
+      REQUIRE(TreeType::Walk(*tree.GetRoot(), recorder));
+
+      VerifyTraversal(expected, recorder.events);
    }
 
-   SECTION("Standard Algorithms and Parameter Passing by reference")
+   SECTION("Walking a Subtree")
    {
-      const auto count = std::count_if(std::begin(tree), std::end(tree),
-         [] (Tree<std::string>::reference node) noexcept
+      const std::vector<std::string> expected =
       {
-         return (node.GetData() == "C");
-      });
+         "+D0", "+C1", "-C1", "+E1", "-E1", "-D0"
+      };
+
+      const TreeType::Node& subtree = *tree.GetRoot()->GetFirstChild()->GetLastChild();
+
+      EventRecorder recorder;
+      TreeType::Walk(subtree, recorder);
+
+      VerifyTraversal(expected, recorder.events);
+   }
+
+   SECTION("Skipping Children and Stopping")
+   {
+      struct PruningVisitor
+      {
+         VisitResult OnEnter(const TreeType::Node& node, unsigned int)
+         {
+            events.emplace_back("+" + node.GetData());
+
+            if (node.GetData() == "B")
+            {
+               return VisitResult::SKIP_CHILDREN;
+            }
+
+            return node.GetData() == "I" ? VisitResult::STOP : VisitResult::CONTINUE;
+         }
+
+         void OnExit(const TreeType::Node& node, unsigned int)
+         {
+            events.emplace_back("-" + node.GetData());
+         }
+
+         std::vector<std::string> events;
+      };
+
+      const std::vector<std::string> expected = { "+F", "+B", "-B", "+G", "+I" };
+
+      PruningVisitor visitor;
+      REQUIRE(!TreeType::Walk(*tree.GetRoot(), visitor));
+
+      VerifyTraversal(expected, visitor.events);
+   }
+
+   SECTION("Building Paths in a Single Pass")
+   {
+      struct PathBuilder
+      {
+         void OnEnter(const TreeType::Node& node, unsigned int depth)
+         {
+            path.resize(depth);
+            path.emplace_back(node.GetData());
+
+            if (!node.HasChildren())
+            {
+               std::string fullPath;
+               for (const auto& component : path)
+               {
+                  fullPath += "/" + component;
+               }
+
+               paths.emplace_back(std::move(fullPath));
+            }
+         }
+
+         void OnExit(const TreeType::Node&, unsigned int)
+         {
+         }
+
+         std::vector<std::string> path;
+         std::vector<std::string> paths;
+      };
+
+      const std::vector<std::string> expected = { "/F/B/A", "/F/B/D/C", "/F/B/D/E", "/F/G/I/H" };
+
+      PathBuilder builder;
+      TreeType::Walk(*tree.GetRoot(), builder);
+
+      VerifyTraversal(expected, builder.paths);
+   }
+}
+
+TEST_CASE("Level-Order Traversal")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   const auto toData = [] (const auto& node) { return node.GetData(); };
+
+   SECTION("Full Traversal")
+   {
+      const std::vector<std::string> expected = { "F", "B", "G", "A", "D", "I", "C", "E", "H" };
+
+      std::vector<std::string> actual;
+      std::transform(tree.beginLevelOrder(), tree.endLevelOrder(), std::back_inserter(actual),
+         toData);
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Depth-Limited Traversal")
+   {
+      const std::vector<std::string> expected = { "F", "B", "G", "A", "D", "I" };
+
+      std::vector<std::string> actual;
+      std::transform(tree.beginLevelOrder(2), tree.endLevelOrder(), std::back_inserter(actual),
+         toData);
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Traversal of a Subtree Tracks the Relative Depth")
+   {
+      const std::vector<std::string> expected = { "B0", "A1", "D1", "C2", "E2" };
+
+      std::vector<std::string> actual;
+
+      auto itr = decltype(tree)::LevelOrderIterator{ tree.GetRoot()->GetFirstChild() };
+      for (; itr != tree.endLevelOrder(); ++itr)
+      {
+         actual.emplace_back(itr->GetData() + std::to_string(itr.GetDepth()));
+      }
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Per-Depth Index")
+   {
+      LevelIndex<decltype(tree)> index{ tree };
+      REQUIRE(index.GatheredNodeCount() == 1);
+
+      std::vector<std::string> actual;
+      const auto& secondLevel = index.Level(2);
+      std::transform(std::begin(secondLevel), std::end(secondLevel), std::back_inserter(actual),
+         [] (const auto* node) { return node->GetData(); });
+
+      const std::vector<std::string> expected = { "A", "D", "I" };
+      VerifyTraversal(expected, actual);
+
+      // Levels below the requested one remain untouched:
+      REQUIRE(index.GatheredLevelCount() == 3);
+      REQUIRE(index.GatheredNodeCount() == 6);
+
+      REQUIRE(index.Level(3).size() == 3);
+      REQUIRE(index.Level(4).empty());
+      REQUIRE(index.Level(10).empty());
+      REQUIRE(index.GatheredNodeCount() == tree.Size());
+   }
+
+   SECTION("Per-Depth Index Notices Structural Changes")
+   {
+      LevelIndex<decltype(tree)> index{ tree };
+      index.Level(2);
+
+      REQUIRE_FALSE(index.IsStale());
+
+      // Changes to data, and below the deepest gathered level, don't affect the gathered levels:
+      tree.GetRoot()->GetFirstChild()->GetFirstChild()->SetData("a");
+      tree.GetRoot()->GetFirstChild()->GetFirstChild()->AppendChild("Z");
+      REQUIRE_FALSE(index.IsStale());
+
+      SECTION("Appending")
+      {
+         tree.GetRoot()->GetLastChild()->AppendChild("J");
+         REQUIRE(index.IsStale());
+      }
+
+      SECTION("Deleting")
+      {
+         tree.GetRoot()->GetLastChild()->GetFirstChild()->DeleteFromTree();
+         REQUIRE(index.IsStale());
+      }
+
+      SECTION("Sorting")
+      {
+         tree.GetRoot()->SortChildren(
+            [] (const auto& lhs, const auto& rhs) { return lhs.GetData() > rhs.GetData(); });
+
+         REQUIRE(index.IsStale());
+      }
+
+      SECTION("Splicing")
+      {
+         tree.GetRoot()->GetFirstChild()->SpliceChildren(*tree.GetRoot()->GetLastChild());
+         REQUIRE(index.IsStale());
+      }
+
+      SECTION("A Fresh Index Is Current Again")
+      {
+         tree.GetRoot()->GetLastChild()->AppendChild("J");
+
+         LevelIndex<decltype(tree)> freshIndex{ tree };
+         REQUIRE(freshIndex.Level(2).size() == 4);
+         REQUIRE_FALSE(freshIndex.IsStale());
+      }
+   }
+}
+
+TEST_CASE("Threaded Leaf List")
+{
+   using TreeType = Tree<std::string, TreeInternals::NoAggregate, true>;
+
+   TreeType tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   // The leaf list has to match the leaves found by walking the Tree, in both directions:
+   const auto verifyLeafList = [] (const TreeType& tree)
+   {
+      std::vector<const TreeType::Node*> expected;
+      TreeType::Traverse<TraversalOrder::PRE_ORDER>(*tree.GetRoot(),
+         [&] (const TreeType::Node& node)
+      {
+         if (!node.HasChildren())
+         {
+            expected.emplace_back(&node);
+         }
+
+         return VisitResult::CONTINUE;
+      });
+
+      std::vector<const TreeType::Node*> forward;
+      for (auto itr = tree.beginLeaf(); itr != tree.endLeaf(); ++itr)
+      {
+         forward.emplace_back(&(*itr));
+      }
+
+      REQUIRE(forward == expected);
+
+      std::vector<const TreeType::Node*> backward;
+      for (auto* leaf = expected.back(); leaf; leaf = leaf->GetPreviousLeaf())
+      {
+         backward.emplace_back(leaf);
+      }
+
+      std::reverse(std::begin(backward), std::end(backward));
+      REQUIRE(backward == expected);
+      REQUIRE(expected.front()->GetPreviousLeaf() == nullptr);
+      REQUIRE(expected.back()->GetNextLeaf() == nullptr);
+   };
+
+   const auto leafData = [] (const TreeType& tree)
+   {
+      std::vector<std::string> data;
+      std::transform(tree.beginLeaf(), tree.endLeaf(), std::back_inserter(data),
+         [] (const auto& node) { return node.GetData(); });
+
+      return data;
+   };
+
+   SECTION("Leaves Are Threaded as the Tree Is Built")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "H" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Adding Children")
+   {
+      tree.GetRoot()->PrependChild("Z");
+      tree.GetRoot()->GetFirstChild()->GetNextSibling()->AppendChild("X");
+      tree.GetRoot()->GetLastChild()->PrependChild("Y");
+      tree.GetRoot()->GetLastChild()->GetLastChild()->GetFirstChild()->AppendChild("J");
+
+      const std::vector<std::string> expected = { "Z", "A", "C", "E", "X", "Y", "J" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Removing Nodes Turns Childless Parents Into Leaves")
+   {
+      tree.GetRoot()->GetLastChild()->GetFirstChild()->GetFirstChild()->DeleteFromTree();
+      tree.GetRoot()->GetFirstChild()->GetFirstChild()->DeleteFromTree();
+
+      const std::vector<std::string> expected = { "C", "E", "I" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Splicing Children")
+   {
+      auto* const g = tree.GetRoot()->GetLastChild();
+      g->SpliceChildren(*tree.GetRoot()->GetFirstChild()->GetLastChild());
+
+      const std::vector<std::string> expected = { "A", "D", "H", "C", "E" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Sorting Children")
+   {
+      const auto descending = [] (const auto& lhs, const auto& rhs) { return rhs < lhs; };
+
+      tree.GetRoot()->SortChildren(descending);
+      tree.GetRoot()->GetLastChild()->SortChildrenBy(
+         [] (const auto& node) { return node.GetData() == "A" ? 1 : 0; });
+
+      std::vector<std::string> expected = { "H", "C", "E", "A" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+
+      tree.SortAll([] (const auto& lhs, const auto& rhs) { return lhs < rhs; },
+         std::execution::par);
+
+      expected = { "A", "C", "E", "H" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Removing Nodes by Predicate")
+   {
+      tree.RemoveIf([] (const auto& node) { return node.GetData() == "C"; });
+
+      std::vector<std::string> expected = { "A", "E", "H" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+
+      tree.RemoveIf(
+         [] (const auto& node) { return node.GetData() == "E" || node.GetData() == "H"; },
+         std::execution::par);
+
+      expected = { "A", "D", "I" };
+
+      verifyLeafList(tree);
+      VerifyTraversal(expected, leafData(tree));
+   }
+
+   SECTION("Iterating Over the Leaves of a Subtree, in Both Directions")
+   {
+      const auto* const b = tree.GetRoot()->GetFirstChild();
+
+      std::vector<std::string> actual;
+      std::transform(TreeType::LeafIterator{ b }, TreeType::LeafIterator::End(b),
+         std::back_inserter(actual), [] (const auto& node) { return node.GetData(); });
+
+      const std::vector<std::string> expected = { "A", "C", "E" };
+      VerifyTraversal(expected, actual);
+
+      auto itr = std::prev(tree.endLeaf());
+      REQUIRE(itr->GetData() == "H");
+      REQUIRE((--itr)->GetData() == "E");
+   }
+
+   SECTION("Copying a Tree Threads the Leaves of the Copy")
+   {
+      const TreeType copy{ tree };
+
+      verifyLeafList(copy);
+      VerifyTraversal(leafData(tree), leafData(copy));
+   }
+}
+
+TEST_CASE("Batch Iteration")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   using TreeType = decltype(tree);
+
+   // Drains the iterator four entries at a time, and records the size of every batch:
+   const auto drain = [] (auto itr, std::vector<std::size_t>& sizes)
+   {
+      std::vector<std::string> data;
+      std::array<const TreeType::Node*, 4> batch;
+
+      while (const auto count = itr.NextBatch(batch.data(), batch.size()))
+      {
+         sizes.emplace_back(count);
+         for (std::size_t index{ 0 }; index < count; ++index)
+         {
+            data.emplace_back(batch[index]->GetData());
+         }
+      }
+
+      return data;
+   };
+
+   SECTION("Each Traversal Order")
+   {
+      std::vector<std::size_t> sizes;
+
+      const std::vector<std::string> preOrder = { "F", "B", "A", "D", "C", "E", "G", "I", "H" };
+      VerifyTraversal(preOrder, drain(tree.beginPreOrder(), sizes));
+
+      const std::vector<std::size_t> expectedSizes = { 4, 4, 1 };
+      VerifyTraversal(expectedSizes, sizes);
+
+      const std::vector<std::string> postOrder = { "A", "C", "E", "D", "B", "H", "I", "G", "F" };
+      VerifyTraversal(postOrder, drain(tree.begin(), sizes));
+
+      const std::vector<std::string> leaves = { "A", "C", "E", "H" };
+      VerifyTraversal(leaves, drain(tree.beginLeaf(), sizes));
+
+      const std::vector<std::string> levels = { "F", "B", "G", "A", "D", "I", "C", "E", "H" };
+      VerifyTraversal(levels, drain(tree.beginLevelOrder(), sizes));
+
+      const std::vector<std::string> subtree = { "D", "C", "E" };
+      const auto* const d = tree.GetRoot()->GetFirstChild()->GetLastChild();
+      VerifyTraversal(subtree, drain(TreeType::PreOrderIterator{ d }, sizes));
+   }
+
+   SECTION("Batches Resume Where the Previous One Ended")
+   {
+      auto itr = tree.beginPreOrder();
+
+      std::array<TreeType::Node*, 3> batch;
+      REQUIRE(itr.NextBatch(batch.data(), batch.size()) == 3);
+      REQUIRE(itr->GetData() == "D");
+
+      REQUIRE(itr.NextBatch(batch.data(), 0) == 0);
+      REQUIRE(itr->GetData() == "D");
+
+      ++itr;
+      REQUIRE(itr.NextBatch(batch.data(), batch.size()) == 3);
+      REQUIRE(batch[0]->GetData() == "C");
+      REQUIRE(batch[2]->GetData() == "G");
+   }
+
+   SECTION("Batches of Data")
+   {
+      std::string concatenated;
+
+      auto itr = tree.beginLevelOrder();
+      std::array<const std::string*, 2> batch;
+
+      while (const auto count = itr.NextBatch(batch.data(), batch.size()))
+      {
+         for (std::size_t index{ 0 }; index < count; ++index)
+         {
+            concatenated += *batch[index];
+         }
+      }
+
+      REQUIRE(concatenated == "FBGADICEH");
+   }
+}
+
+TEST_CASE("Parallel ForEach")
+{
+   // An uneven Tree: the directories grow wider from left to right, and every other one is nested
+   // a few levels deeper than its siblings.
+   Tree<int> tree{ 0 };
+
+   int nextValue = 1;
+   for (int directory = 0; directory < 40; ++directory)
+   {
+      auto* parent = tree.GetRoot()->AppendChild(nextValue++);
+      if (directory % 2)
+      {
+         for (int level = 0; level < 3; ++level)
+         {
+            parent = parent->AppendChild(nextValue++);
+         }
+      }
+
+      for (int file = 0; file < directory * 25; ++file)
+      {
+         parent->AppendChild(nextValue++);
+      }
+   }
+
+   const auto nodeCount = static_cast<std::size_t>(nextValue);
+   REQUIRE(tree.Size() == nodeCount);
+
+   ParallelOptions options;
+   options.threadCount = 4;
+   options.grainSize = 64;
+
+   // Each thread records what it visits on its own, so that the visitor needs no locking:
+   std::vector<std::vector<int>> visitedByThread(options.threadCount);
+
+   const auto record = [&] (const Tree<int>::Node& node, unsigned int thread)
+   {
+      visitedByThread[thread].emplace_back(node.GetData());
+   };
+
+   const auto allVisited = [&]
+   {
+      std::vector<int> visited;
+      for (const auto& values : visitedByThread)
+      {
+         visited.insert(std::end(visited), std::begin(values), std::end(values));
+      }
+
+      std::sort(std::begin(visited), std::end(visited));
+      return visited;
+   };
+
+   std::vector<int> expected(nodeCount);
+   std::iota(std::begin(expected), std::end(expected), 0);
+
+   SECTION("Every Node is Visited Exactly Once")
+   {
+      const Tree<int>& constTree = tree;
+      Tree<int>::ParallelForEach(*constTree.GetRoot(), record, options);
+
+      REQUIRE(allVisited() == expected);
+   }
+
+   SECTION("Runs of Small Siblings Are Visited Exactly Once")
+   {
+      Tree<int> flatTree{ 0 };
+      for (int file = 1; file <= 10000; ++file)
+      {
+         flatTree.GetRoot()->AppendChild(file);
+      }
+
+      std::vector<int> flatExpected(10001);
+      std::iota(std::begin(flatExpected), std::end(flatExpected), 0);
+
+      Tree<int>::ParallelForEach(*flatTree.GetRoot(), record, options);
+
+      REQUIRE(allVisited() == flatExpected);
+   }
+
+   SECTION("Nodes May Be Modified")
+   {
+      Tree<int>::ParallelForEach(*tree.GetRoot(), [] (Tree<int>::Node& node) noexcept
+      {
+         node.GetData() *= 2;
+      }, options);
+
+      const auto sum = std::accumulate(tree.beginPreOrder(), tree.endPreOrder(), 0,
+         [] (int total, const auto& node) { return total + node.GetData(); });
+
+      REQUIRE(sum == 2 * std::accumulate(std::begin(expected), std::end(expected), 0));
+   }
+
+   SECTION("Small Subtrees Are Visited Sequentially")
+   {
+      options.grainSize = nodeCount * 2;
+      Tree<int>::ParallelForEach(*tree.GetRoot(), record, options);
+
+      REQUIRE(visitedByThread.front().size() == nodeCount);
+      REQUIRE(allVisited() == expected);
+   }
+
+   SECTION("A Single Thread")
+   {
+      options.threadCount = 1;
+      Tree<int>::ParallelForEach(*tree.GetRoot(), record, options);
+
+      REQUIRE(visitedByThread.front().size() == nodeCount);
+   }
+
+   SECTION("Exceptions Are Propagated")
+   {
+      const auto throwOnLast = [&] (const Tree<int>::Node& node)
+      {
+         if (node.GetData() == nextValue - 1)
+         {
+            throw std::runtime_error{ "Visitor failed." };
+         }
+      };
+
+      REQUIRE_THROWS_AS(Tree<int>::ParallelForEach(*tree.GetRoot(), throwOnLast, options),
+         const std::runtime_error&);
+   }
+}
+
+TEST_CASE("Parallel Fold")
+{
+   ParallelOptions options;
+   options.threadCount = 4;
+   options.grainSize = 1;
+
+   SECTION("Children Are Combined in Order")
+   {
+      Tree<std::string> tree{ "F" };
+
+      tree.GetRoot()->AppendChild("B")->AppendChild("A");
+      tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+      tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+      tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+      const auto ownName = [] (const Tree<std::string>::Node& node) { return node.GetData(); };
+      const auto concatenate = [] (std::string value, const std::string& child)
+      {
+         return value + child;
+      };
+
+      // Since children are combined in order, every value spells out its subtree in pre-order:
+      const std::vector<std::string> expected =
+         { "FBADCEGIH", "BADCE", "A", "DCE", "C", "E", "GIH", "IH", "H" };
+
+      const auto values = Tree<std::string>::ParallelFoldUp(
+         *tree.GetRoot(), ownName, concatenate, options);
+
+      VerifyTraversal(expected, values);
+
+      const auto sequentialValues = Tree<std::string>::ParallelFoldUp(
+         *tree.GetRoot(), ownName, concatenate, ParallelOptions{ 1 });
+
+      VerifyTraversal(expected, sequentialValues);
+   }
+
+   // The same uneven Tree as for ParallelForEach, with every Node holding its own "size":
+   Tree<int> tree{ 0 };
+
+   int nextValue = 1;
+   for (int directory = 0; directory < 40; ++directory)
+   {
+      auto* parent = tree.GetRoot()->AppendChild(nextValue++);
+      if (directory % 2)
+      {
+         for (int level = 0; level < 3; ++level)
+         {
+            parent = parent->AppendChild(nextValue++);
+         }
+      }
+
+      for (int file = 0; file < directory * 25; ++file)
+      {
+         parent->AppendChild(nextValue++);
+      }
+   }
+
+   options.grainSize = 64;
+
+   std::vector<std::size_t> expectedCounts;
+   std::vector<int> expectedSums;
+
+   std::for_each(tree.beginPreOrder(), tree.endPreOrder(), [&] (const Tree<int>::Node& node)
+   {
+      const auto first = Tree<int>::PreOrderIterator{ &node };
+      const auto last = Tree<int>::PreOrderIterator{ };
+
+      expectedCounts.emplace_back(std::distance(first, last));
+      expectedSums.emplace_back(std::accumulate(first, last, 0,
+         [] (int total, const auto& descendant) { return total + descendant.GetData(); }));
+   });
+
+   SECTION("Counts and Depths Into a Side Array")
+   {
+      const auto counts = Tree<int>::ParallelFoldUp(*tree.GetRoot(),
+         [] (const Tree<int>::Node&) noexcept { return std::size_t{ 1 }; },
+         std::plus<std::size_t>{ },
+         options);
+
+      REQUIRE(counts == expectedCounts);
+
+      const auto heights = Tree<int>::ParallelFoldUp(*tree.GetRoot(),
+         [] (const Tree<int>::Node&) noexcept { return 0u; },
+         [] (unsigned int height, unsigned int child) noexcept
+      {
+         return std::max(height, child + 1);
+      }, options);
+
+      REQUIRE(heights.size() == tree.Size());
+      REQUIRE(heights.front() == 5);
+   }
+
+   SECTION("Totals Into the Nodes")
+   {
+      const auto total = Tree<int>::ParallelFoldUpInto(*tree.GetRoot(),
+         [] (const Tree<int>::Node& node) noexcept { return node.GetData(); },
+         std::plus<int>{ },
+         [] (Tree<int>::Node& node, int sum) noexcept { node.GetData() = sum; },
+         options);
+
+      REQUIRE(total == expectedSums.front());
+
+      std::vector<int> actualSums;
+      std::transform(tree.beginPreOrder(), tree.endPreOrder(), std::back_inserter(actualSums),
+         [] (const Tree<int>::Node& node) { return node.GetData(); });
+
+      REQUIRE(actualSums == expectedSums);
+   }
+}
+
+#if defined(__cpp_impl_coroutine)
+TEST_CASE("Coroutine Generators")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   using TreeType = decltype(tree);
+
+   const auto collect = [] (auto&& generator)
+   {
+      std::vector<std::string> data;
+      for (const auto& node : generator)
+      {
+         data.emplace_back(node.GetData());
+      }
+
+      return data;
+   };
+
+   SECTION("Each Traversal Order")
+   {
+      const auto& root = *tree.GetRoot();
+
+      const std::vector<std::string> preOrder = { "F", "B", "A", "D", "C", "E", "G", "I", "H" };
+      VerifyTraversal(preOrder, collect(TreeType::PreOrderGenerator(root)));
+
+      const std::vector<std::string> postOrder = { "A", "C", "E", "D", "B", "H", "I", "G", "F" };
+      VerifyTraversal(postOrder, collect(TreeType::PostOrderGenerator(root)));
+
+      const std::vector<std::string> leaves = { "A", "C", "E", "H" };
+      VerifyTraversal(leaves, collect(TreeType::LeafGenerator(root)));
+
+      const std::vector<std::string> levels = { "F", "B", "G", "A", "D", "I" };
+      VerifyTraversal(levels, collect(TreeType::LevelOrderGenerator(root, 2)));
+
+      const std::vector<std::string> subtree = { "D", "C", "E" };
+      VerifyTraversal(subtree,
+         collect(TreeType::PreOrderGenerator(*root.GetFirstChild()->GetLastChild())));
+   }
+
+   SECTION("Interleaved Consumption")
+   {
+      auto generator = TreeType::PreOrderGenerator(*tree.GetRoot());
+
+      std::vector<std::string> pages;
+      std::string page;
+
+      for (auto itr = std::begin(generator); itr != std::end(generator); ++itr)
+      {
+         (*itr).GetData() += "!";
+         page += (*itr).GetData();
+
+         if (page.size() == 6)
+         {
+            pages.emplace_back(std::move(page));
+            page.clear();
+         }
+      }
+
+      REQUIRE(page.empty());
+
+      const std::vector<std::string> expected = { "F!B!A!", "D!C!E!", "G!I!H!" };
+      VerifyTraversal(expected, pages);
+   }
+
+   SECTION("Pruning")
+   {
+      const auto shouldDescend = [] (const TreeType::Node& node)
+      {
+         return node.GetData() != "B";
+      };
+
+      const std::vector<std::string> expected = { "F", "B", "G", "I", "H" };
+      VerifyTraversal(expected,
+         collect(TreeType::PrunedPreOrderGenerator(*tree.GetRoot(), shouldDescend)));
+   }
+
+   SECTION("Abandoning a Generator Early")
+   {
+      std::vector<std::string> actual;
+      for (const auto& node : TreeType::PostOrderGenerator(*tree.GetRoot()))
+      {
+         actual.emplace_back(node.GetData());
+         if (actual.size() == 2)
+         {
+            break;
+         }
+      }
+
+      const std::vector<std::string> expected = { "A", "C" };
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Paired Walk")
+   {
+      Tree<std::string> other{ "F" };
+      other.GetRoot()->AppendChild("C")->AppendChild("X");
+      other.GetRoot()->AppendChild("G")->AppendChild("I");
+
+      const auto toString = [] (const std::pair<TreeType::Node*, TreeType::Node*>& pair)
+      {
+         return (pair.first ? pair.first->GetData() : "-")
+            + (pair.second ? pair.second->GetData() : "-");
+      };
+
+      std::vector<std::string> positional;
+      for (const auto& pair :
+         TreeType::PairedPreOrderGenerator(*tree.GetRoot(), *other.GetRoot()))
+      {
+         positional.emplace_back(toString(pair));
+      }
+
+      const std::vector<std::string> expectedPositional =
+         { "FF", "BC", "AX", "D-", "C-", "E-", "GG", "II", "H-" };
+
+      VerifyTraversal(expectedPositional, positional);
+
+      const auto isLess = [] (const TreeType::Node& lhs, const TreeType::Node& rhs)
+      {
+         return lhs.GetData() < rhs.GetData();
+      };
+
+      std::vector<std::string> merged;
+      for (const auto& pair :
+         TreeType::PairedPreOrderGenerator(*tree.GetRoot(), *other.GetRoot(), isLess))
+      {
+         merged.emplace_back(toString(pair));
+      }
+
+      const std::vector<std::string> expectedMerged =
+         { "FF", "B-", "A-", "D-", "C-", "E-", "-C", "-X", "GG", "II", "H-" };
+
+      VerifyTraversal(expectedMerged, merged);
+   }
+}
+#endif
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("Composable Range Views")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   using TreeType = decltype(tree);
+
+   static_assert(std::ranges::bidirectional_range<TreeType::PreOrderView>);
+   static_assert(std::ranges::bidirectional_range<TreeType::PostOrderView>);
+   static_assert(std::ranges::bidirectional_range<TreeType::LeafView>);
+   static_assert(std::ranges::forward_range<TreeType::LevelOrderView>);
+   static_assert(std::ranges::borrowed_range<TreeType::PreOrderView>);
+   static_assert(std::sentinel_for<TreeType::Sentinel, TreeType::PreOrderIterator>);
+
+   const auto toData = [] (const TreeType::Node& node) { return node.GetData(); };
+
+   const auto collect = [&] (auto&& range)
+   {
+      std::vector<std::string> data;
+      std::ranges::transform(range, std::back_inserter(data), toData);
+
+      return data;
+   };
+
+   SECTION("Traversal Views")
+   {
+      const std::vector<std::string> preOrder = { "F", "B", "A", "D", "C", "E", "G", "I", "H" };
+      VerifyTraversal(preOrder, collect(tree.PreOrder()));
+
+      const std::vector<std::string> postOrder = { "A", "C", "E", "D", "B", "H", "I", "G", "F" };
+      VerifyTraversal(postOrder, collect(tree.PostOrder()));
+
+      const std::vector<std::string> leaves = { "A", "C", "E", "H" };
+      VerifyTraversal(leaves, collect(tree.Leaves()));
+
+      const std::vector<std::string> levels = { "F", "B", "G" };
+      VerifyTraversal(levels, collect(tree.LevelOrder(1)));
+
+      const std::vector<std::string> reversed = { "E", "C", "D", "A", "B" };
+      VerifyTraversal(reversed,
+         collect(TreeType::Subtree(*tree.GetRoot()->GetFirstChild()) | std::views::reverse));
+   }
+
+   SECTION("Depth-Limited View")
+   {
+      const std::vector<std::string> expected = { "F", "B", "A", "D", "G", "I" };
+      VerifyTraversal(expected, collect(tree.PreOrder() | TreeViews::DepthLimited(2)));
+
+      std::vector<std::string> depths;
+      const auto view = TreeType::Subtree(*tree.GetRoot()->GetFirstChild())
+         | TreeViews::DepthLimited(1);
+
+      for (auto itr = std::ranges::begin(view); itr != std::ranges::end(view); ++itr)
+      {
+         depths.emplace_back(itr->GetData() + std::to_string(itr.GetDepth()));
+      }
+
+      const std::vector<std::string> expectedDepths = { "B0", "A1", "D1" };
+      VerifyTraversal(expectedDepths, depths);
+   }
+
+   SECTION("Pruning Subtrees Stays Lazy")
+   {
+      std::vector<std::string> inspected;
+      const auto isNotB = [&] (const TreeType::Node& node)
+      {
+         inspected.emplace_back(node.GetData());
+         return node.GetData() != "B";
+      };
+
+      const std::vector<std::string> expected = { "F", "G", "I", "H" };
+      VerifyTraversal(expected, collect(tree.PreOrder() | TreeViews::FilterSubtrees(isNotB)));
+
+      // None of the descendants of the rejected Node were ever looked at:
+      const std::vector<std::string> expectedInspected = { "F", "B", "G", "I", "H" };
+      VerifyTraversal(expectedInspected, inspected);
+
+      inspected.clear();
+
+      const auto firstTwo = tree.PreOrder()
+         | TreeViews::FilterSubtrees(isNotB)
+         | TreeViews::Take(2);
+
+      const std::vector<std::string> expectedFirstTwo = { "F", "G" };
+      VerifyTraversal(expectedFirstTwo, collect(firstTwo));
+
+      // Taking the second Node advances the traversal one last time, but no further than that:
+      const std::vector<std::string> expectedInspectedFirstTwo = { "F", "B", "G", "I" };
+      VerifyTraversal(expectedInspectedFirstTwo, inspected);
+   }
+
+   SECTION("Composing Tree-Aware and Standard Views")
+   {
+      const auto isNotD = [] (const TreeType::Node& node) { return node.GetData() != "D"; };
+
+      auto pipeline = tree.PreOrder()
+         | TreeViews::FilterSubtrees(isNotD)
+         | TreeViews::DepthLimited(2)
+         | std::views::transform(toData)
+         | TreeViews::Take(4);
+
+      std::vector<std::string> actual;
+      std::ranges::copy(pipeline, std::back_inserter(actual));
+
+      const std::vector<std::string> expected = { "F", "B", "A", "G" };
+      VerifyTraversal(expected, actual);
+   }
+}
+#endif
+
+TEST_CASE("Partial Tree Iteration")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   SECTION("Pre-Order Iteration")
+   {
+      const std::vector<std::string> expected = { "B", "A", "D", "C", "E" };
+
+      const auto begin = decltype(tree)::PreOrderIterator{ tree.GetRoot()->GetFirstChild() };
+      const auto end = decltype(tree)::PreOrderIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Post-Order Iteration")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "D", "B" };
+
+      const auto begin = decltype(tree)::PostOrderIterator{ tree.GetRoot()->GetFirstChild() };
+      const auto end = decltype(tree)::PostOrderIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+}
+
+TEST_CASE("Partial Tree Iteration Corner Cases")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   SECTION("Pre-Order Iteration")
+   {
+      const std::vector<std::string> expected = { "D", "C", "E" };
+
+      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+
+      const auto begin = decltype(tree)::PreOrderIterator{ startingNode };
+      const auto end = decltype(tree)::PreOrderIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Post-Order Iteration")
+   {
+      const std::vector<std::string> expected = { "C", "E", "D" };
+
+      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+
+      const auto begin = decltype(tree)::PostOrderIterator{ startingNode };
+      const auto end = decltype(tree)::PostOrderIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Leaf Iteration")
+   {
+      const std::vector<std::string> expected = { "C", "E" };
+
+      const auto* startingNode = tree.GetRoot()->GetFirstChild()->GetLastChild();
+
+      const auto begin = decltype(tree)::LeafIterator{ startingNode };
+      const auto end = decltype(tree)::LeafIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+}
+
+TEST_CASE("STL Typedef Compliance")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   SECTION("Standard Algorithms and Parameter Passing by value_type")
+   {
+      const auto count = std::count_if(std::begin(tree), std::end(tree),
+         [] (Tree<std::string>::value_type node) noexcept
+      {
+         return (node.GetData() == "A");
+      });
+
+      REQUIRE(count == 1);
+   }
+
+   SECTION("Standard Algorithms and Parameter Passing by reference")
+   {
+      const auto count = std::count_if(std::begin(tree), std::end(tree),
+         [] (Tree<std::string>::reference node) noexcept
+      {
+         return (node.GetData() == "C");
+      });
+
+      REQUIRE(count == 1);
+   }
+
+   SECTION("Standard Algorithms and Parameter Passing by const_reference")
+   {
+      const auto count = std::count_if(std::begin(tree), std::end(tree),
+         [] (Tree<std::string>::const_reference node) noexcept
+      {
+         return (node.GetData() == "D");
+      });
+
+      REQUIRE(count == 1);
+   }
+}
+
+TEST_CASE("Leaf Iterator")
+{
+   Tree<std::string> tree{ "F" };
+
+   tree.GetRoot()->AppendChild("B")->AppendChild("A");
+   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
+   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
+   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+
+   SECTION("Forward Traversal")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "H", };
+
+      const auto begin = decltype(tree)::LeafIterator{ tree.GetRoot() };
+      const auto end = decltype(tree)::LeafIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Partial Tree Iteration")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E" };
+
+      const auto begin = decltype(tree)::LeafIterator{ tree.GetRoot()->GetFirstChild() };
+      const auto end = decltype(tree)::LeafIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("Tree<T>::beginLeaf and Tree<T>::endLeaf")
+   {
+      const std::vector<std::string> expected = { "A", "C", "E", "H", };
+
+      std::vector<std::string> actual;
+      std::transform(tree.beginLeaf(), tree.endLeaf(), std::back_inserter(actual),
+         [] (Tree<std::string>::const_reference node) { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+}
+
+TEST_CASE("Sibling Iterator")
+{
+   Tree<std::string> tree{ "IDK" };
+
+   tree.GetRoot()->AppendChild("B");
+   tree.GetRoot()->AppendChild("D");
+   tree.GetRoot()->AppendChild("A");
+   tree.GetRoot()->AppendChild("C");
+   tree.GetRoot()->AppendChild("F");
+   tree.GetRoot()->AppendChild("G");
+   tree.GetRoot()->AppendChild("E");
+   tree.GetRoot()->AppendChild("H");
+
+   SECTION("Forward Traversal")
+   {
+      const std::vector<std::string> expected = { "B", "D", "A", "C", "F", "G", "E", "H", };
+
+      const auto begin = decltype(tree)::SiblingIterator{ tree.GetRoot()->GetFirstChild() };
+      const auto end = decltype(tree)::SiblingIterator{ };
+
+      std::vector<std::string> actual;
+      std::transform(begin, end, std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+}
+
+TEST_CASE("Sorting")
+{
+   SECTION("One Generation of Children")
+   {
+      Tree<std::string> tree{ "X" };
+
+      tree.GetRoot()->AppendChild("B");
+      tree.GetRoot()->AppendChild("D");
+      tree.GetRoot()->AppendChild("A");
+      tree.GetRoot()->AppendChild("C");
+      tree.GetRoot()->AppendChild("F");
+      tree.GetRoot()->AppendChild("G");
+      tree.GetRoot()->AppendChild("E");
+      tree.GetRoot()->AppendChild("H");
+
+      tree.GetRoot()->SortChildren(
+         [] (const auto& lhs, const auto& rhs) noexcept { return (lhs < rhs); });
+
+      const std::vector<std::string> expected = { "A", "B", "C", "D", "E", "F", "G", "H", "X" };
+
+      std::vector<std::string> actual;
+      std::transform(std::begin(tree), std::end(tree), std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("An Entire Tree")
+   {
+      Tree<int> tree{ 666 };
+      tree.GetRoot()->AppendChild(37);
+
+      tree.GetRoot()->GetFirstChild()->AppendChild(6);
+      tree.GetRoot()->GetFirstChild()->AppendChild(8);
+      tree.GetRoot()->GetFirstChild()->AppendChild(2);
+      tree.GetRoot()->GetFirstChild()->AppendChild(3);
+      tree.GetRoot()->GetFirstChild()->AppendChild(1);
+      tree.GetRoot()->GetFirstChild()->AppendChild(0);
+      tree.GetRoot()->GetFirstChild()->AppendChild(-5);
+
+      tree.GetRoot()->AppendChild(48);
+      tree.GetRoot()->AppendChild(17);
+      tree.GetRoot()->AppendChild(12);
+
+      const auto sizeBeforeSort = tree.Size();
+
+      std::for_each(std::begin(tree), std::end(tree),
+         [] (auto& node) noexcept
+      {
+         node.SortChildren([] (auto& lhs, auto& rhs) noexcept { return lhs < rhs; });
+      });
+
+      const auto sizeAfterSort = tree.Size();
+
+      REQUIRE(sizeBeforeSort == sizeAfterSort);
+
+      const std::vector<int> expected = { 12, 17, -5, 0, 1, 2, 3, 6, 8, 37, 48, 666 };
+
+      std::vector<int> actual;
+      std::transform(std::begin(tree), std::end(tree), std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+
+   SECTION("An Entire Tree, In Parallel")
+   {
+      // Each node carries a sort key that collides often, and a unique identifier that allows the
+      // relative order of equal keys to be checked as well:
+      Tree<std::pair<int, int>> tree{ { 0, 0 } };
+
+      int identifier = 0;
+      for (int directory = 0; directory < 50; ++directory)
+      {
+         auto* const child = tree.GetRoot()->AppendChild({ (directory * 31) % 7, ++identifier });
+         for (int file = 0; file < 20; ++file)
+         {
+            child->AppendChild({ (file * 17) % 5, ++identifier });
+         }
+      }
+
+      // One sibling list that's large enough to be split across workers:
+      auto* const largeDirectory = tree.GetRoot()->GetFirstChild();
+      for (int file = 0; file < 10'000; ++file)
+      {
+         largeDirectory->AppendChild({ (file * 7919) % 100, ++identifier });
+      }
+
+      const auto comparator = [] (const auto& lhs, const auto& rhs) noexcept
+      {
+         return lhs.GetData().first < rhs.GetData().first;
+      };
+
+      Tree<std::pair<int, int>> sequentiallySorted{ tree };
+      std::for_each(std::begin(sequentiallySorted), std::end(sequentiallySorted),
+         [&] (auto& node) { node.SortChildren(comparator); });
+
+      tree.SortAll(comparator, std::execution::par);
+
+      std::vector<std::pair<int, int>> expected;
+      std::transform(
+         sequentiallySorted.beginPreOrder(), sequentiallySorted.endPreOrder(),
+         std::back_inserter(expected), [] (const auto& node) { return node.GetData(); });
+
+      std::vector<std::pair<int, int>> actual;
+      std::transform(tree.beginPreOrder(), tree.endPreOrder(), std::back_inserter(actual),
+         [] (const auto& node) { return node.GetData(); });
+
+      REQUIRE(actual == expected);
+   }
+
+   SECTION("Sibling Links Are Repaired")
+   {
+      Tree<int> tree{ 0 };
+
+      tree.GetRoot()->AppendChild(3);
+      tree.GetRoot()->AppendChild(1);
+      tree.GetRoot()->AppendChild(2);
+
+      tree.GetRoot()->SortChildren(
+         [] (const auto& lhs, const auto& rhs) noexcept { return lhs.GetData() < rhs.GetData(); });
+
+      const auto* const first = tree.GetRoot()->GetFirstChild();
+      const auto* const last = tree.GetRoot()->GetLastChild();
+
+      REQUIRE(first->GetData() == 1);
+      REQUIRE(first->GetPreviousSibling() == nullptr);
+      REQUIRE(first->GetNextSibling()->GetData() == 2);
+      REQUIRE(first->GetNextSibling()->GetPreviousSibling() == first);
+      REQUIRE(last->GetData() == 3);
+      REQUIRE(last->GetPreviousSibling()->GetData() == 2);
+      REQUIRE(last->GetNextSibling() == nullptr);
+   }
+
+   SECTION("By Integral Key")
+   {
+      Tree<int> tree{ 0 };
+
+      // Enough children to take the radix sort path, with both negative and positive keys:
+      std::vector<int> expected;
+      for (int index = 0; index < 500; ++index)
+      {
+         const auto value = (index * 7919) % 1000 - 500;
+         tree.GetRoot()->AppendChild(value);
+         expected.emplace_back(value);
+      }
+
+      tree.GetRoot()->SortChildrenBy([] (const auto& node) noexcept { return node.GetData(); });
+
+      std::sort(std::begin(expected), std::end(expected));
+
+      std::vector<int> actual;
+      for (const auto* child = tree.GetRoot()->GetFirstChild(); child;
+         child = child->GetNextSibling())
+      {
+         actual.emplace_back(child->GetData());
+      }
+
+      REQUIRE(actual == expected);
+      REQUIRE(tree.GetRoot()->GetLastChild()->GetData() == expected.back());
+      REQUIRE(tree.GetRoot()->GetChildCount() == expected.size());
+   }
+
+   SECTION("By Non-Integral Key Is Stable")
+   {
+      Tree<std::string> tree{ "X" };
+
+      tree.GetRoot()->AppendChild("Bb");
+      tree.GetRoot()->AppendChild("Aa");
+      tree.GetRoot()->AppendChild("Ab");
+      tree.GetRoot()->AppendChild("Ba");
+
+      tree.GetRoot()->SortChildrenBy(
+         [] (const auto& node) { return node.GetData().substr(0, 1); });
+
+      const std::vector<std::string> expected = { "Aa", "Ab", "Bb", "Ba", "X" };
+
+      std::vector<std::string> actual;
+      std::transform(std::begin(tree), std::end(tree), std::back_inserter(actual),
+         [] (const auto& node) noexcept { return node.GetData(); });
+
+      VerifyTraversal(expected, actual);
+   }
+}
+
+TEST_CASE("Top-K Queries")
+{
+   Tree<int> tree{ 0 };
+
+   std::vector<int> leaves;
+   for (int directory = 1; directory <= 20; ++directory)
+   {
+      auto* const child = tree.GetRoot()->AppendChild(-directory);
+      for (int file = 0; file < 30; ++file)
+      {
+         const auto value = (directory * 31 + file * 7919) % 1000;
+         child->AppendChild(value);
+         leaves.emplace_back(value);
+      }
+   }
+
+   std::sort(std::begin(leaves), std::end(leaves), std::greater<int>{ });
+
+   const auto key = [] (const auto& node) noexcept { return node.GetData(); };
+
+   SECTION("Across the Whole Tree")
+   {
+      const auto isLeaf = [] (const auto& node) noexcept { return !node.HasChildren(); };
+
+      const auto topTen = Tree<int>::TopK(*tree.GetRoot(), 10, key, isLeaf);
+
+      std::vector<int> actual;
+      std::transform(std::begin(topTen), std::end(topTen), std::back_inserter(actual),
+         [] (const auto* node) noexcept { return node->GetData(); });
+
+      REQUIRE(actual == std::vector<int>(std::begin(leaves), std::begin(leaves) + 10));
+   }
+
+   SECTION("Across Many Tasks")
+   {
+      // Large enough for the search to be split up into tasks, with the best candidates nested
+      // in various directories:
+      Tree<int> largeTree{ -1 };
+      for (int directory = 0; directory < 16; ++directory)
+      {
+         auto* const child = largeTree.GetRoot()->AppendChild(-1);
+         for (int file = 0; file < 1000; ++file)
+         {
+            child->AppendChild((directory * 1000 + file) * 7919 % 16000);
+         }
+      }
+
+      const auto topThree = Tree<int>::TopK(*largeTree.GetRoot(), 3, key,
+         [] (const auto& node) noexcept { return !node.HasChildren(); });
+
+      std::vector<int> actual;
+      std::transform(std::begin(topThree), std::end(topThree), std::back_inserter(actual),
+         [] (const auto* node) noexcept { return node->GetData(); });
+
+      const std::vector<int> expected = { 15999, 15998, 15997 };
+      REQUIRE(actual == expected);
+   }
+
+   SECTION("With More Requested Than Available")
+   {
+      const auto isDirectory = [] (const auto& node) noexcept { return node.HasChildren(); };
+
+      const auto directories = Tree<int>::TopK(
+         *tree.GetRoot(), 100, key, isDirectory, std::execution::seq);
+
+      REQUIRE(directories.size() == 20);
+      REQUIRE(directories.front()->GetData() == -1);
+      REQUIRE(directories.back()->GetData() == -20);
+   }
+
+   SECTION("Among Children")
+   {
+      const auto* const directory = tree.GetRoot()->GetFirstChild();
+
+      std::vector<int> expected;
+      for (const auto* child = directory->GetFirstChild(); child; child = child->GetNextSibling())
+      {
+         expected.emplace_back(child->GetData());
+      }
+
+      std::sort(std::begin(expected), std::end(expected), std::greater<int>{ });
+      expected.resize(5);
+
+      const auto topFive = directory->TopKChildren(5, key);
+
+      std::vector<int> actual;
+      std::transform(std::begin(topFive), std::end(topFive), std::back_inserter(actual),
+         [] (const auto* node) noexcept { return node->GetData(); });
+
+      REQUIRE(actual == expected);
+      REQUIRE(directory->GetChildCount() == 30);
+   }
+}
+
+namespace
+{
+   struct SumAggregate
+   {
+      using ValueType = long long;
+
+      static ValueType Lift(int data) noexcept { return data; }
+      static ValueType Combine(ValueType lhs, ValueType rhs) noexcept { return lhs + rhs; }
+      static ValueType Subtract(ValueType total, ValueType part) noexcept { return total - part; }
+   };
+
+   struct MaxAggregate
+   {
+      using ValueType = int;
+
+      static ValueType Lift(int data) noexcept { return data; }
+      static ValueType Combine(ValueType lhs, ValueType rhs) noexcept { return std::max(lhs, rhs); }
+   };
+}
+
+TEST_CASE("Subtree Aggregates")
+{
+   SECTION("Invertible Aggregate")
+   {
+      Tree<int, SumAggregate> tree{ 1 };
+
+      auto* const lhs = tree.GetRoot()->AppendChild(10);
+      auto* const rhs = tree.GetRoot()->PrependChild(100);
+
+      lhs->AppendChild(2);
+      auto* const leaf = lhs->AppendChild(3);
+      rhs->AppendChild(4);
+
+      REQUIRE(tree.GetRoot()->GetAggregate() == 120);
+      REQUIRE(lhs->GetAggregate() == 15);
+      REQUIRE(rhs->GetAggregate() == 104);
+
+      leaf->SetData(30);
+
+      REQUIRE(lhs->GetAggregate() == 42);
+      REQUIRE(tree.GetRoot()->GetAggregate() == 147);
+
+      rhs->DeleteFromTree();
+
+      REQUIRE(tree.GetRoot()->GetAggregate() == 43);
+
+      Tree<int, SumAggregate>::Node donor{ 0 };
+      donor.AppendChild(5);
+      donor.AppendChild(6);
+
+      leaf->SpliceChildren(donor);
 
-      REQUIRE(count == 1);
+      REQUIRE(donor.GetAggregate() == 0);
+      REQUIRE(leaf->GetAggregate() == 41);
+      REQUIRE(tree.GetRoot()->GetAggregate() == 54);
+
+      const Tree<int, SumAggregate> copy{ tree };
+      REQUIRE(copy.GetRoot()->GetAggregate() == 54);
+
+      // With the donor inside the same Tree, only the aggregates between the two Nodes change:
+      auto* const recipient = tree.GetRoot()->AppendChild(0);
+      recipient->SpliceChildren(*lhs);
+
+      REQUIRE(lhs->GetAggregate() == 10);
+      REQUIRE(recipient->GetAggregate() == 43);
+      REQUIRE(tree.GetRoot()->GetAggregate() == 54);
    }
 
-   SECTION("Standard Algorithms and Parameter Passing by const_reference")
+   SECTION("Non-Invertible Aggregate")
    {
-      const auto count = std::count_if(std::begin(tree), std::end(tree),
-         [] (Tree<std::string>::const_reference node) noexcept
-      {
-         return (node.GetData() == "D");
-      });
+      Tree<int, MaxAggregate> tree{ 0 };
 
-      REQUIRE(count == 1);
+      auto* const directory = tree.GetRoot()->AppendChild(1);
+      directory->AppendChild(7);
+      auto* const largest = directory->AppendChild(9);
+      tree.GetRoot()->AppendChild(4);
+
+      REQUIRE(tree.GetRoot()->GetAggregate() == 9);
+
+      largest->DeleteFromTree();
+
+      REQUIRE(directory->GetAggregate() == 7);
+      REQUIRE(tree.GetRoot()->GetAggregate() == 7);
+
+      directory->DeleteFromTree();
+
+      REQUIRE(tree.GetRoot()->GetAggregate() == 4);
+
+      tree.GetRoot()->SetData(12);
+
+      REQUIRE(tree.GetRoot()->GetAggregate() == 12);
    }
 }
 
-TEST_CASE("Leaf Iterator")
+TEST_CASE("Pre-Order Column")
 {
-   Tree<std::string> tree{ "F" };
-
-   tree.GetRoot()->AppendChild("B")->AppendChild("A");
-   tree.GetRoot()->GetFirstChild()->AppendChild("D")->AppendChild("C");
-   tree.GetRoot()->GetFirstChild()->GetLastChild()->AppendChild("E");
-   tree.GetRoot()->AppendChild("G")->AppendChild("I")->AppendChild("H");
+   Tree<int> tree{ 1 };
 
-   SECTION("Forward Traversal")
-   {
-      const std::vector<std::string> expected = { "A", "C", "E", "H", };
+   auto* const lhs = tree.GetRoot()->AppendChild(10);
+   lhs->AppendChild(100);
+   auto* const grandchild = lhs->AppendChild(1'000);
+   grandchild->AppendChild(10'000);
 
-      const auto begin = decltype(tree)::LeafIterator{ tree.GetRoot() };
-      const auto end = decltype(tree)::LeafIterator{ };
+   auto* const rhs = tree.GetRoot()->AppendChild(100'000);
+   rhs->AppendChild(1'000'000);
 
-      std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+   using ColumnType = PreOrderColumn<Tree<int>, long long>;
 
-      VerifyTraversal(expected, actual);
-   }
+   const auto valueOf = [] (const auto& node) noexcept { return node.GetData(); };
 
-   SECTION("Partial Tree Iteration")
+   SECTION("By Position")
    {
-      const std::vector<std::string> expected = { "A", "C", "E" };
+      const ColumnType column{ tree, valueOf };
 
-      const auto begin = decltype(tree)::LeafIterator{ tree.GetRoot()->GetFirstChild() };
-      const auto end = decltype(tree)::LeafIterator{ };
+      REQUIRE(column.Size() == 7);
+      REQUIRE(column.Total() == 1'111'111);
 
-      std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+      // In pre-order: the root, lhs, its two children, the grandchild's child, rhs, and its child.
+      REQUIRE(column.SubtreeSum(0) == 1'111'111);
+      REQUIRE(column.SubtreeSum(1) == 11'110);
+      REQUIRE(column.SubtreeSum(3) == 11'000);
+      REQUIRE(column.SubtreeSum(5) == 1'100'000);
 
-      VerifyTraversal(expected, actual);
+      REQUIRE(column.SubtreeCount(0) == 7);
+      REQUIRE(column.SubtreeCount(1) == 4);
+      REQUIRE(column.SubtreeCount(6) == 1);
+
+      REQUIRE(column.SubtreeEnd(1) == 5);
+      REQUIRE(column.SubtreeEnd(5) == 7);
    }
 
-   SECTION("Tree<T>::beginLeaf and Tree<T>::endLeaf")
+   SECTION("By Node")
    {
-      const std::vector<std::string> expected = { "A", "C", "E", "H", };
+      const ColumnType column{ tree, valueOf, ColumnType::NodeLookup::ENABLED };
 
-      std::vector<std::string> actual;
-      std::transform(tree.beginLeaf(), tree.endLeaf(), std::back_inserter(actual),
-         [] (Tree<std::string>::const_reference node) { return node.GetData(); });
+      REQUIRE(column.Position(*rhs) == 5);
 
-      VerifyTraversal(expected, actual);
+      REQUIRE(column.SubtreeSum(*tree.GetRoot()) == 1'111'111);
+      REQUIRE(column.SubtreeSum(*lhs) == 11'110);
+      REQUIRE(column.SubtreeSum(*grandchild) == 11'000);
+      REQUIRE(column.SubtreeSum(*rhs) == 1'100'000);
+
+      REQUIRE(column.SubtreeCount(*tree.GetRoot()) == 7);
+      REQUIRE(column.SubtreeCount(*lhs) == 4);
+      REQUIRE(column.SubtreeCount(*grandchild) == 2);
+      REQUIRE(column.SubtreeCount(*rhs->GetFirstChild()) == 1);
    }
 }
 
-TEST_CASE("Sibling Iterator")
+TEST_CASE("Predicate-Based Removal")
 {
-   Tree<std::string> tree{ "IDK" };
+   // Builds a tree in which every node with an odd value has its subtree removed:
+   const auto buildTree = [] ()
+   {
+      Tree<int> tree{ 0 };
 
-   tree.GetRoot()->AppendChild("B");
-   tree.GetRoot()->AppendChild("D");
-   tree.GetRoot()->AppendChild("A");
-   tree.GetRoot()->AppendChild("C");
-   tree.GetRoot()->AppendChild("F");
-   tree.GetRoot()->AppendChild("G");
-   tree.GetRoot()->AppendChild("E");
-   tree.GetRoot()->AppendChild("H");
+      for (int directory = 1; directory <= 6; ++directory)
+      {
+         auto* const child = tree.GetRoot()->AppendChild(directory);
+         for (int file = 1; file <= 4; ++file)
+         {
+            child->AppendChild(directory * 10 + file);
+         }
+      }
 
-   SECTION("Forward Traversal")
-   {
-      const std::vector<std::string> expected = { "B", "D", "A", "C", "F", "G", "E", "H", };
+      return tree;
+   };
 
-      const auto begin = decltype(tree)::SiblingIterator{ tree.GetRoot()->GetFirstChild() };
-      const auto end = decltype(tree)::SiblingIterator{ };
+   const auto isOdd = [] (const auto& node) noexcept { return node.GetData() % 2 != 0; };
 
-      std::vector<std::string> actual;
-      std::transform(begin, end, std::back_inserter(actual),
+   // Directories 2, 4, and 6 survive, along with their two even files each:
+   const std::vector<int> expected = { 0, 2, 22, 24, 4, 42, 44, 6, 62, 64 };
+
+   const auto verify = [&] (const Tree<int>& tree)
+   {
+      std::vector<int> actual;
+      std::transform(tree.beginPreOrder(), tree.endPreOrder(), std::back_inserter(actual),
          [] (const auto& node) noexcept { return node.GetData(); });
 
-      VerifyTraversal(expected, actual);
+      REQUIRE(actual == expected);
+      REQUIRE(tree.GetRoot()->GetChildCount() == 3);
+      REQUIRE(tree.GetRoot()->GetFirstChild()->GetPreviousSibling() == nullptr);
+      REQUIRE(tree.GetRoot()->GetLastChild()->GetData() == 6);
+      REQUIRE(tree.GetRoot()->GetLastChild()->GetNextSibling() == nullptr);
+      REQUIRE(tree.GetRoot()->GetLastChild()->GetPreviousSibling()->GetData() == 4);
+   };
+
+   SECTION("Sequentially")
+   {
+      auto tree = buildTree();
+
+      // Three odd directories with four files each, and two odd files in each even directory:
+      REQUIRE(tree.RemoveIf(isOdd) == 3 * 5 + 3 * 2);
+      verify(tree);
    }
-}
 
-TEST_CASE("Sorting")
-{
-   SECTION("One Generation of Children")
+   SECTION("In Parallel")
    {
-      Tree<std::string> tree{ "X" };
+      auto tree = buildTree();
 
-      tree.GetRoot()->AppendChild("B");
-      tree.GetRoot()->AppendChild("D");
-      tree.GetRoot()->AppendChild("A");
-      tree.GetRoot()->AppendChild("C");
-      tree.GetRoot()->AppendChild("F");
-      tree.GetRoot()->AppendChild("G");
-      tree.GetRoot()->AppendChild("E");
-      tree.GetRoot()->AppendChild("H");
+      REQUIRE(tree.RemoveIf(isOdd, std::execution::par) == 3 * 5 + 3 * 2);
+      verify(tree);
+   }
 
-      tree.GetRoot()->SortChildren(
-         [] (const auto& lhs, const auto& rhs) noexcept { return (lhs < rhs); });
+   SECTION("With Aggregates")
+   {
+      Tree<int, SumAggregate> tree{ 0 };
 
-      const std::vector<std::string> expected = { "A", "B", "C", "D", "E", "F", "G", "H", "X" };
+      auto* const directory = tree.GetRoot()->AppendChild(2);
+      directory->AppendChild(3);
+      directory->AppendChild(4);
+      tree.GetRoot()->AppendChild(5)->AppendChild(6);
 
-      std::vector<std::string> actual;
-      std::transform(std::begin(tree), std::end(tree), std::back_inserter(actual),
-         [] (const auto& node) noexcept { return node.GetData(); });
+      REQUIRE(tree.RemoveIf(isOdd) == 3);
+      REQUIRE(directory->GetAggregate() == 6);
+      REQUIRE(tree.GetRoot()->GetAggregate() == 6);
+   }
+}
 
-      VerifyTraversal(expected, actual);
+TEST_CASE("Erasing During Iteration")
+{
+   Tree<int> tree{ 0 };
+
+   for (int directory = 1; directory <= 4; ++directory)
+   {
+      auto* const child = tree.GetRoot()->AppendChild(directory);
+      for (int file = 1; file <= 3; ++file)
+      {
+         child->AppendChild(directory * 10 + file);
+      }
    }
 
-   SECTION("An Entire Tree")
+   const auto isOdd = [] (const auto& node) noexcept { return node->GetData() % 2 != 0; };
+
+   SECTION("Pre-Order")
    {
-      Tree<int> tree{ 666 };
-      tree.GetRoot()->AppendChild(37);
+      std::vector<int> visited;
 
-      tree.GetRoot()->GetFirstChild()->AppendChild(6);
-      tree.GetRoot()->GetFirstChild()->AppendChild(8);
-      tree.GetRoot()->GetFirstChild()->AppendChild(2);
-      tree.GetRoot()->GetFirstChild()->AppendChild(3);
-      tree.GetRoot()->GetFirstChild()->AppendChild(1);
-      tree.GetRoot()->GetFirstChild()->AppendChild(0);
-      tree.GetRoot()->GetFirstChild()->AppendChild(-5);
+      auto itr = tree.beginPreOrder();
+      while (itr != tree.endPreOrder())
+      {
+         visited.emplace_back(itr->GetData());
+         itr = isOdd(itr) ? tree.Erase(itr) : std::next(itr);
+      }
 
-      tree.GetRoot()->AppendChild(48);
-      tree.GetRoot()->AppendChild(17);
-      tree.GetRoot()->AppendChild(12);
+      // The subtrees of erased nodes are never visited:
+      const std::vector<int> expectedVisits = { 0, 1, 2, 21, 22, 23, 3, 4, 41, 42, 43 };
+      REQUIRE(visited == expectedVisits);
 
-      const auto sizeBeforeSort = tree.Size();
+      std::vector<int> remaining;
+      std::transform(tree.beginPreOrder(), tree.endPreOrder(), std::back_inserter(remaining),
+         [] (const auto& node) noexcept { return node.GetData(); });
 
-      std::for_each(std::begin(tree), std::end(tree),
-         [] (auto& node) noexcept
-      {
-         node.SortChildren([] (auto& lhs, auto& rhs) noexcept { return lhs < rhs; });
-      });
+      const std::vector<int> expectedRemaining = { 0, 2, 22, 4, 42 };
+      REQUIRE(remaining == expectedRemaining);
+   }
 
-      const auto sizeAfterSort = tree.Size();
+   SECTION("Post-Order")
+   {
+      std::vector<int> visited;
 
-      REQUIRE(sizeBeforeSort == sizeAfterSort);
+      auto itr = std::begin(tree);
+      while (itr != std::end(tree))
+      {
+         visited.emplace_back(itr->GetData());
+         itr = isOdd(itr) ? tree.Erase(itr) : std::next(itr);
+      }
 
-      const std::vector<int> expected = { 12, 17, -5, 0, 1, 2, 3, 6, 8, 37, 48, 666 };
+      const std::vector<int> expectedVisits =
+         { 11, 12, 13, 1, 21, 22, 23, 2, 31, 32, 33, 3, 41, 42, 43, 4, 0 };
 
-      std::vector<int> actual;
-      std::transform(std::begin(tree), std::end(tree), std::back_inserter(actual),
+      REQUIRE(visited == expectedVisits);
+
+      std::vector<int> remaining;
+      std::transform(std::begin(tree), std::end(tree), std::back_inserter(remaining),
          [] (const auto& node) noexcept { return node.GetData(); });
 
-      VerifyTraversal(expected, actual);
+      const std::vector<int> expectedRemaining = { 22, 2, 42, 4, 0 };
+      REQUIRE(remaining == expectedRemaining);
    }
 }
 
@@ -1027,3 +2856,237 @@ TEST_CASE("Selectively Delecting Nodes")
       REQUIRE(DESTRUCTION_COUNT == treeSize);
    }
 }
+
+TEST_CASE("Quantile Sketch")
+{
+   constexpr double ACCURACY{ 0.02 };
+
+   // File sizes spread out over eight orders of magnitude:
+   std::mt19937_64 generator{ 42 };
+   std::uniform_real_distribution<double> exponent{ 0.0, 20.0 };
+
+   std::vector<std::uintmax_t> values(100'000);
+   std::generate(std::begin(values), std::end(values),
+      [&] { return static_cast<std::uintmax_t>(std::exp(exponent(generator))); });
+
+   const auto sortedValues = [&]
+   {
+      auto sorted = values;
+      std::sort(std::begin(sorted), std::end(sorted));
+      return sorted;
+   }();
+
+   const auto exactQuantile = [&] (double quantile)
+   {
+      const auto rank = static_cast<std::size_t>(quantile * (sortedValues.size() - 1));
+      return static_cast<double>(sortedValues[rank]);
+   };
+
+   const std::vector<double> quantiles = { 0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0 };
+
+   SECTION("Quantiles Are Within the Relative Accuracy")
+   {
+      QuantileSketch sketch{ ACCURACY, QuantileSketch::BucketsToCover(ACCURACY, 1, 1ull << 40) };
+      for (const auto value : values)
+      {
+         sketch.Add(value);
+      }
+
+      REQUIRE(sketch.Count() == values.size());
+
+      for (const auto quantile : quantiles)
+      {
+         const auto exact = exactQuantile(quantile);
+         const auto estimate = static_cast<double>(sketch.Quantile(quantile));
+
+         REQUIRE(std::abs(estimate - exact) <= ACCURACY * exact + 1e-9);
+      }
+   }
+
+   SECTION("Merged Sketches Are Within the Relative Accuracy")
+   {
+      const auto bucketCount = QuantileSketch::BucketsToCover(ACCURACY, 1, 1ull << 40);
+
+      QuantileSketch lhs{ ACCURACY, bucketCount };
+      QuantileSketch rhs{ ACCURACY, bucketCount };
+
+      for (std::size_t index{ 0 }; index < values.size(); ++index)
+      {
+         (index % 2 ? lhs : rhs).Add(values[index]);
+      }
+
+      lhs.Merge(rhs);
+
+      REQUIRE(lhs.Count() == values.size());
+
+      for (const auto quantile : quantiles)
+      {
+         const auto exact = exactQuantile(quantile);
+         const auto estimate = static_cast<double>(lhs.Quantile(quantile));
+
+         REQUIRE(std::abs(estimate - exact) <= ACCURACY * exact + 1e-9);
+      }
+   }
+
+   SECTION("Only the Smallest Values Lose Accuracy")
+   {
+      // Far too few buckets for the range of values, so that the lowest ones have to be collapsed:
+      QuantileSketch sketch{ ACCURACY, 64 };
+      for (const auto value : values)
+      {
+         sketch.Add(value);
+      }
+
+      const auto exact = exactQuantile(0.99);
+      const auto estimate = static_cast<double>(sketch.Quantile(0.99));
+
+      REQUIRE(std::abs(estimate - exact) <= ACCURACY * exact + 1e-9);
+      REQUIRE(static_cast<double>(sketch.Quantile(0.01)) > exactQuantile(0.01));
+   }
+
+   SECTION("Zeroes and Empty Sketches")
+   {
+      QuantileSketch sketch{ ACCURACY, 16 };
+      REQUIRE(sketch.Quantile(0.5) == 0);
+
+      sketch.Add(0);
+      sketch.Add(0);
+      sketch.Add(1'000);
+
+      REQUIRE(sketch.Quantile(0.0) == 0);
+      REQUIRE(sketch.Quantile(0.5) == 0);
+      REQUIRE(std::abs(static_cast<double>(sketch.Quantile(1.0)) - 1'000.0) <= 20.0);
+   }
+
+   SECTION("Bucket Budget")
+   {
+      // One byte to one terabyte spans 27.6 natural orders of magnitude, and at 2%, every bucket
+      // covers ln(1.02 / 0.98), or about 0.04, of that:
+      const auto bucketCount = QuantileSketch::BucketsToCover(ACCURACY, 1, 1ull << 40);
+
+      REQUIRE(bucketCount >= 690);
+      REQUIRE(bucketCount <= 700);
+   }
+}
+
+TEST_CASE("HyperLogLog")
+{
+   constexpr std::uint8_t PRECISION{ 10 };
+
+   // The standard error is 1.04 / sqrt(2^10), or about 3.3%; four standard errors make for a bound
+   // that a correct implementation essentially never exceeds with a fixed set of values:
+   const double tolerance = 4.0 * 1.04 / std::sqrt(1 << PRECISION);
+
+   const auto isWithinBounds = [&] (std::uint64_t estimate, std::uint64_t exact)
+   {
+      const auto error = std::abs(static_cast<double>(estimate) - static_cast<double>(exact));
+      return error <= tolerance * static_cast<double>(exact);
+   };
+
+   SECTION("Small Cardinalities")
+   {
+      HyperLogLog sketch{ PRECISION };
+      REQUIRE(sketch.Estimate() == 0);
+
+      for (std::uint64_t value{ 0 }; value < 100; ++value)
+      {
+         sketch.Add(HyperLogLog::Hash(value));
+      }
+
+      // Linear counting takes over while most registers are still empty, and does even better:
+      REQUIRE(isWithinBounds(sketch.Estimate(), 100));
+   }
+
+   SECTION("Large Cardinalities")
+   {
+      for (const std::uint64_t cardinality : { 5'000ull, 50'000ull, 500'000ull })
+      {
+         HyperLogLog sketch{ PRECISION };
+         for (std::uint64_t value{ 0 }; value < cardinality; ++value)
+         {
+            sketch.Add(HyperLogLog::Hash(value));
+         }
+
+         REQUIRE(isWithinBounds(sketch.Estimate(), cardinality));
+      }
+   }
+
+   SECTION("Duplicates Are Not Counted")
+   {
+      HyperLogLog sketch{ PRECISION };
+      for (int repetition = 0; repetition < 10; ++repetition)
+      {
+         for (std::uint64_t value{ 0 }; value < 10'000; ++value)
+         {
+            sketch.Add(HyperLogLog::Hash(value));
+         }
+      }
+
+      REQUIRE(isWithinBounds(sketch.Estimate(), 10'000));
+   }
+
+   SECTION("Merging Estimates the Union")
+   {
+      HyperLogLog lhs{ PRECISION };
+      HyperLogLog rhs{ PRECISION };
+
+      // The two halves overlap by 10,000 values:
+      for (std::uint64_t value{ 0 }; value < 30'000; ++value)
+      {
+         lhs.Add(HyperLogLog::Hash(value));
+         rhs.Add(HyperLogLog::Hash(value + 20'000));
+      }
+
+      lhs.Merge(rhs);
+
+      REQUIRE(isWithinBounds(lhs.Estimate(), 50'000));
+   }
+}
+
+TEST_CASE("UTF-8 Round Trip")
+{
+   const auto encode = [] (std::wstring_view text)
+   {
+      std::string encoded(Utf8::EncodedLength(text), '\0');
+      Utf8::Encode(text, encoded.data());
+
+      return encoded;
+   };
+
+   SECTION("Encoding")
+   {
+      REQUIRE(encode(L"readme.txt") == "readme.txt");
+      REQUIRE(encode(L"Gr\u00F6\u00DFe") == "Gr\xC3\xB6\xC3\x9F" "e");
+      REQUIRE(encode(L"\u6587\u4EF6") == "\xE6\x96\x87\xE4\xBB\xB6");
+      REQUIRE(encode(L"\U0001F600") == "\xF0\x9F\x98\x80");
+   }
+
+   SECTION("Decoding Restores the Original")
+   {
+      const std::wstring_view names[] =
+      {
+         L"",
+         L"readme.txt",
+         L"Gr\u00F6\u00DFe.pdf",
+         L"\u6587\u4EF6.doc",
+         L"smile\U0001F600.png"
+      };
+
+      for (const auto name : names)
+      {
+         REQUIRE(Utf8::Decode(encode(name)) == name);
+      }
+   }
+
+   SECTION("Unpaired Surrogates Survive")
+   {
+      const std::wstring name{ L'a', static_cast<wchar_t>(0xD800), L'b' };
+      REQUIRE(Utf8::Decode(encode(name)) == name);
+   }
+
+   SECTION("Malformed Input Decodes to the Replacement Character")
+   {
+      REQUIRE(Utf8::Decode("a\xC3") == L"a\uFFFD");
+      REQUIRE(Utf8::Decode("\xFF" "b") == L"\uFFFD" L"b");
+   }
+}